@@ -0,0 +1,141 @@
+#include "bench.hxx"
+#include <alloc.hxx>
+
+#include <cstdint>
+#include <vector>
+
+using Checked = xxint::Checked<std::size_t>;
+
+namespace {
+
+const std::size_t count = 1 << 14;
+
+struct Entry
+{
+    uint64_t key;
+    uint32_t value;
+};
+
+// Requests for 1 to 16 entries, then a string of up to 64 characters, as
+// a parser building a tree of small nodes would make.
+const std::vector<std::size_t>& sizes()
+{
+    static auto result = bench::random_ints<std::size_t>(count, 1, 64);
+    return result;
+}
+
+const std::size_t capacity = 1 << 16;
+
+// Enough room for the largest request.
+const std::size_t slack = 64 + 16 * sizeof(Entry) + 16;
+
+std::size_t arena_allocate(std::size_t iterations)
+{
+    xxint::arena a(capacity);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (auto size : sizes()) {
+            if (a.remaining() < slack) a.reset();
+            bench::keep(a.allocate<Entry>(size % 16 + 1));
+            bench::keep(a.allocate<char>(size));
+        }
+    }
+
+    return 2 * count;
+}
+
+// The same bump pointer, with each step of the size checked separately.
+class Step_checked_arena
+{
+public:
+    explicit Step_checked_arena(std::size_t capacity)
+            : data_(new unsigned char[capacity]), capacity_(capacity)
+    { }
+
+    ~Step_checked_arena() { delete[] data_; }
+
+    template <class T>
+    T* allocate(Checked n)
+    {
+        auto address = reinterpret_cast<std::uintptr_t>(data_ + offset_);
+        Checked pad = std::size_t(-address & (alignof(T) - 1));
+        Checked size = n * sizeof(T) + pad;
+        if (size > Checked(capacity_) - offset_) throw std::bad_alloc();
+        T* result = reinterpret_cast<T*>(data_ + offset_ + pad.get());
+        offset_ = (size + offset_).get();
+        return result;
+    }
+
+    std::size_t remaining() const { return capacity_ - offset_; }
+    void reset() { offset_ = 0; }
+
+private:
+    unsigned char* data_;
+    std::size_t capacity_;
+    std::size_t offset_ = 0;
+};
+
+std::size_t step_checked(std::size_t iterations)
+{
+    Step_checked_arena a(capacity);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (auto size : sizes()) {
+            if (a.remaining() < slack) a.reset();
+            bench::keep(a.allocate<Entry>(size % 16 + 1));
+            bench::keep(a.allocate<char>(size));
+        }
+    }
+
+    return 2 * count;
+}
+
+// An unchecked bump pointer, whose size arithmetic can wrap.
+std::size_t unchecked(std::size_t iterations)
+{
+    std::vector<unsigned char> buffer(capacity);
+    std::size_t offset = 0;
+
+    auto allocate = [&](std::size_t size, std::size_t align) {
+        auto address = reinterpret_cast<std::uintptr_t>(&buffer[offset]);
+        std::size_t pad = std::size_t(-address & (align - 1));
+        if (size + pad > capacity - offset) throw std::bad_alloc();
+        void* result = &buffer[offset + pad];
+        offset += size + pad;
+        return result;
+    };
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (auto size : sizes()) {
+            if (capacity - offset < slack) offset = 0;
+            bench::keep(allocate((size % 16 + 1) * sizeof(Entry),
+                                 alignof(Entry)));
+            bench::keep(allocate(size, 1));
+        }
+    }
+
+    return 2 * count;
+}
+
+std::size_t heap(std::size_t iterations)
+{
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (auto size : sizes()) {
+            auto entries = new Entry[size % 16 + 1];
+            auto chars = new char[size];
+            bench::keep(entries);
+            bench::keep(chars);
+            delete[] chars;
+            delete[] entries;
+        }
+    }
+
+    return 2 * count;
+}
+
+bench::Register r1("Alloc arena", arena_allocate);
+bench::Register r2("Alloc arena checked at each step", step_checked);
+bench::Register r3("Alloc arena unchecked", unchecked);
+bench::Register r4("Alloc new and delete", heap);
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace bench {
+
+// A benchmark body runs its workload `iterations` times and returns the
+// number of items processed per iteration, which is used to report the
+// time per item.
+using body_t = std::function<std::size_t(std::size_t iterations)>;
+
+struct Benchmark
+{
+    const char* name;
+    body_t body;
+
+    // If nonzero, the size of an item, for reporting throughput too.
+    std::size_t item_bytes;
+};
+
+// All registered benchmarks, in registration order.
+std::vector<Benchmark>& registry();
+
+// Registers a benchmark at static initialization time:
+//
+//     static bench::Register r("name", [](std::size_t n) { ...; return k; });
+//
+// Given the size of an item in bytes, it reports throughput in GB/s too.
+struct Register
+{
+    Register(const char* name, body_t body, std::size_t item_bytes = 0)
+    {
+        registry().push_back({name, std::move(body), item_bytes});
+    }
+};
+
+// Prevents the compiler from optimizing away the computation of `value`.
+template <class T>
+inline void keep(T const& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// `count` uniformly distributed values in `[lo, hi]`, from a fixed seed so
+// that runs are comparable.
+template <class T>
+std::vector<T> random_ints(std::size_t count, T lo, T hi)
+{
+    std::mt19937_64 rng(count);
+    std::uniform_int_distribution<long long> dist(lo, hi);
+    std::vector<T> result(count);
+    for (auto& each : result)
+        each = static_cast<T>(dist(rng));
+    return result;
+}
+
+}
@@ -0,0 +1,49 @@
+#include "bench.hxx"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace bench {
+
+std::vector<Benchmark>& registry()
+{
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+}
+
+// Runs each benchmark whose name contains `argv[1]` (or every benchmark),
+// doubling the iteration count until a run takes at least 200 ms. An
+// untimed first run builds any lazily created inputs.
+int main(int argc, char* argv[])
+{
+    using clock = std::chrono::steady_clock;
+    const char* filter = argc > 1 ? argv[1] : "";
+
+    for (auto const& each : bench::registry()) {
+        if (std::strstr(each.name, filter) == nullptr) continue;
+
+        each.body(1);
+
+        std::size_t iterations = 1;
+        for (;;) {
+            auto start = clock::now();
+            std::size_t items = each.body(iterations);
+            std::chrono::duration<double, std::nano> elapsed =
+                    clock::now() - start;
+
+            if (elapsed.count() >= 2e8) {
+                double per_item = elapsed.count() / double(iterations * items);
+                std::printf("%-48s %10.3f ns/item", each.name, per_item);
+                if (each.item_bytes != 0)
+                    std::printf(" %8.2f GB/s", each.item_bytes / per_item);
+                std::printf("\n");
+                break;
+            }
+
+            iterations *= 2;
+        }
+    }
+}
@@ -0,0 +1,107 @@
+#include "bench.hxx"
+#include <cursor.hxx>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using xxint::byte_cursor;
+using xxint::byte_order;
+
+namespace {
+
+const std::size_t count = 1 << 14;
+
+// A message of a big-endian count, then that many 14-byte records of a
+// big-endian 32-bit id, 64-bit price, and 16-bit quantity.
+const std::vector<uint8_t>& message()
+{
+    static std::vector<uint8_t> result;
+
+    if (result.empty()) {
+        auto bytes = bench::random_ints<int>(14 * count, 0, 255);
+        for (int shift = 24; shift >= 0; shift -= 8)
+            result.push_back(uint8_t(count >> shift));
+        for (auto each : bytes)
+            result.push_back(uint8_t(each));
+    }
+
+    return result;
+}
+
+// Every field read through the cursor, each checked.
+std::size_t each_checked(std::size_t iterations)
+{
+    const auto& in = message();
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        byte_cursor cursor(in.data(), in.size());
+        uint64_t sum = 0;
+        auto n = cursor.read<uint32_t, byte_order::big>();
+        for (uint32_t j = 0; j < n; ++j) {
+            sum += cursor.read<uint32_t, byte_order::big>();
+            sum += uint64_t(cursor.read<int64_t, byte_order::big>());
+            sum += cursor.read<uint16_t, byte_order::big>();
+        }
+        bench::keep(sum);
+    }
+
+    return count;
+}
+
+// The records' total length checked once.
+std::size_t record_checked(std::size_t iterations)
+{
+    const auto& in = message();
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        byte_cursor cursor(in.data(), in.size());
+        uint64_t sum = 0;
+        auto n = cursor.read<uint32_t, byte_order::big>();
+        auto records = cursor.record(byte_cursor::size_type(n) * 14);
+        for (uint32_t j = 0; j < n; ++j) {
+            sum += records.read<uint32_t, byte_order::big>();
+            sum += uint64_t(records.read<int64_t, byte_order::big>());
+            sum += records.read<uint16_t, byte_order::big>();
+        }
+        bench::keep(sum);
+    }
+
+    return count;
+}
+
+template <class U>
+U load_be(const uint8_t* p)
+{
+    U value;
+    std::memcpy(&value, p, sizeof value);
+    return xxint::detail::byte_swap(value);
+}
+
+// A hand-written parser, checking each record's length.
+std::size_t hand_written(std::size_t iterations)
+{
+    const auto& in = message();
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        const uint8_t* p = in.data();
+        const uint8_t* end = p + in.size();
+        uint64_t sum = 0;
+        uint32_t n = load_be<uint32_t>(p);
+        p += 4;
+        for (uint32_t j = 0; j < n && end - p >= 14; ++j, p += 14) {
+            sum += load_be<uint32_t>(p);
+            sum += load_be<uint64_t>(p + 4);
+            sum += load_be<uint16_t>(p + 12);
+        }
+        bench::keep(sum);
+    }
+
+    return count;
+}
+
+bench::Register r1("Cursor read each field", each_checked);
+bench::Register r2("Cursor read record", record_checked);
+bench::Register r3("Cursor hand-written loop", hand_written);
+
+}
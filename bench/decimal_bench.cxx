@@ -0,0 +1,162 @@
+#include "bench.hxx"
+#include <decimal.hxx>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using namespace xxint;
+
+namespace {
+
+using Money = Decimal<int64_t, 2>;
+
+const std::size_t count = 4096;
+
+const std::vector<int64_t>& cents()
+{
+    static auto result = bench::random_ints<int64_t>(count, -1000000, 1000000);
+    return result;
+}
+
+const std::vector<std::string>& texts()
+{
+    static std::vector<std::string> result = [] {
+        std::vector<std::string> strings;
+        char buffer[32];
+        for (auto raw : cents()) {
+            auto r = to_chars(buffer, buffer + sizeof buffer, Money::from_raw(raw));
+            strings.emplace_back(buffer, r.ptr);
+        }
+        return strings;
+    }();
+    return result;
+}
+
+std::size_t decimal_sum(std::size_t iterations)
+{
+    std::vector<Money> in;
+    for (auto raw : cents()) in.push_back(Money::from_raw(raw));
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        Money total;
+        for (auto each : in) total += each;
+        bench::keep(total);
+    }
+
+    return count;
+}
+
+std::size_t int64_sum(std::size_t iterations)
+{
+    auto const& in = cents();
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        int64_t total = 0;
+        for (auto each : in) total += each;
+        bench::keep(total);
+    }
+
+    return count;
+}
+
+std::size_t decimal_mul(std::size_t iterations)
+{
+    std::vector<Money> in, out(count);
+    for (auto raw : cents()) in.push_back(Money::from_raw(raw));
+    auto rate = Money::from_raw(108);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t j = 0; j < count; ++j)
+            out[j] = in[j] * rate;
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+std::size_t double_mul(std::size_t iterations)
+{
+    std::vector<double> in, out(count);
+    for (auto raw : cents()) in.push_back(raw / 100.0);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t j = 0; j < count; ++j)
+            out[j] = in[j] * 1.08;
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+std::size_t decimal_from_chars(std::size_t iterations)
+{
+    auto const& in = texts();
+    std::vector<Money> out(count);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t j = 0; j < count; ++j)
+            from_chars(in[j].data(), in[j].data() + in[j].size(), out[j]);
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+std::size_t strtod_parse(std::size_t iterations)
+{
+    auto const& in = texts();
+    std::vector<double> out(count);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t j = 0; j < count; ++j)
+            out[j] = std::strtod(in[j].c_str(), nullptr);
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+std::size_t decimal_to_chars(std::size_t iterations)
+{
+    std::vector<Money> in;
+    for (auto raw : cents()) in.push_back(Money::from_raw(raw));
+    char buffer[32];
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (auto each : in) {
+            to_chars(buffer, buffer + sizeof buffer, each);
+            bench::keep(buffer);
+        }
+    }
+
+    return count;
+}
+
+std::size_t snprintf_format(std::size_t iterations)
+{
+    std::vector<double> in;
+    for (auto raw : cents()) in.push_back(raw / 100.0);
+    char buffer[32];
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (auto each : in) {
+            std::snprintf(buffer, sizeof buffer, "%.2f", each);
+            bench::keep(buffer);
+        }
+    }
+
+    return count;
+}
+
+bench::Register r1("Decimal<int64_t,2> sum", decimal_sum);
+bench::Register r2("int64_t sum (unchecked)", int64_sum);
+bench::Register r3("Decimal<int64_t,2> multiply", decimal_mul);
+bench::Register r4("double multiply", double_mul);
+bench::Register r5("Decimal<int64_t,2> from_chars", decimal_from_chars);
+bench::Register r6("strtod", strtod_parse);
+bench::Register r7("Decimal<int64_t,2> to_chars", decimal_to_chars);
+bench::Register r8("snprintf %.2f", snprintf_format);
+
+}
@@ -0,0 +1,125 @@
+#include "bench.hxx"
+#include <delta.hxx>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using xxint::delta_order;
+
+namespace {
+
+const std::size_t count = 1 << 16;
+
+// Millisecond timestamps at a roughly steady interval, a random walk, and
+// random 20-bit values: one column to suit each order.
+template <class T>
+const std::vector<xxint::Checked<T>>& column(delta_order order)
+{
+    static std::vector<xxint::Checked<T>> result[3];
+    auto& column = result[int(order)];
+
+    if (column.empty()) {
+        auto noise = bench::random_ints<int>(count, -8, 8);
+        auto big   = bench::random_ints<int>(count, 0, (1 << 20) - 1);
+        T value = order == delta_order::delta_of_delta ? T(1600000000) : T(0);
+        for (std::size_t i = 0; i < count; ++i) {
+            switch (order) {
+            case delta_order::none:  value = T(big[i]); break;
+            case delta_order::delta: value = T(value + noise[i]); break;
+            default:                 value = T(value + 1000 + noise[i] / 4);
+            }
+            column.emplace_back(value);
+        }
+    }
+
+    return column;
+}
+
+template <class T>
+std::vector<uint8_t> packed(delta_order order, std::size_t block)
+{
+    const auto& in = column<T>(order);
+    std::vector<uint8_t> out(xxint::max_packed_bytes<T>(count, block));
+    auto end = xxint::pack_column(out.data(), out.data() + out.size(),
+                                  in.data(), in.size(), order, block).ptr;
+    out.resize(std::size_t(end - out.data()));
+    return out;
+}
+
+template <class T>
+std::size_t pack(std::size_t iterations, delta_order order, std::size_t block)
+{
+    const auto& in = column<T>(order);
+    std::vector<uint8_t> out(xxint::max_packed_bytes<T>(count, block));
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        auto result = xxint::pack_column(out.data(), out.data() + out.size(),
+                                         in.data(), in.size(), order, block);
+        bench::keep(result.ptr);
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+template <class T, template <class> class P = xxint::policy::throwing>
+std::size_t unpack(std::size_t iterations, const std::vector<uint8_t>& in)
+{
+    std::vector<xxint::Checked<T, P>> out(count);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        xxint::unpack_column(in.data(), in.data() + in.size(),
+                             out.data(), out.size());
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+std::size_t copy(std::size_t iterations)
+{
+    const auto& in = column<int64_t>(delta_order::none);
+    std::vector<xxint::Checked<int64_t>> out(count);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        std::memcpy(out.data(), in.data(), count * sizeof(int64_t));
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+// Throughput is of the unpacked values.
+#define DELTA_BENCH(T, order, block)                                        \
+    bench::Register pack_##T##_##order##_##block(                           \
+            "Delta pack " #T " " #order " " #block,                         \
+            [](std::size_t n) {                                             \
+                return pack<T>(n, delta_order::order, block);               \
+            }, sizeof(T));                                                  \
+    bench::Register unpack_##T##_##order##_##block(                         \
+            "Delta unpack " #T " " #order " " #block,                       \
+            [](std::size_t n) {                                             \
+                static auto in = packed<T>(delta_order::order, block);      \
+                return unpack<T>(n, in);                                    \
+            }, sizeof(T));
+
+DELTA_BENCH(int64_t, none, 128)
+DELTA_BENCH(int64_t, delta, 128)
+DELTA_BENCH(int64_t, delta_of_delta, 128)
+DELTA_BENCH(int64_t, delta, 1024)
+DELTA_BENCH(int64_t, delta_of_delta, 1024)
+DELTA_BENCH(int32_t, none, 128)
+DELTA_BENCH(int32_t, delta, 128)
+DELTA_BENCH(int32_t, delta_of_delta, 128)
+
+#undef DELTA_BENCH
+
+bench::Register unpack_wrapping("Delta unpack int64_t delta 128, Wrapping",
+        [](std::size_t n) {
+            static auto in = packed<int64_t>(delta_order::delta, 128);
+            return unpack<int64_t, xxint::policy::wrapping>(n, in);
+        }, sizeof(int64_t));
+bench::Register memcpy_column("Delta memcpy int64_t", copy, sizeof(int64_t));
+
+}
@@ -0,0 +1,170 @@
+#include "bench.hxx"
+#include <fields.hxx>
+
+#include <climits>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using Checked = xxint::Checked<long>;
+
+namespace {
+
+const std::size_t count = 1 << 16;
+
+// Comma-separated fields of 1 to 6 digits, like counters in a CSV file, or
+// of 1 to 19 digits.
+const std::string& text(bool long_fields)
+{
+    static std::string result[2];
+    std::string& text = result[long_fields];
+
+    if (text.empty()) {
+        auto values = bench::random_ints<long>(count, LONG_MIN, LONG_MAX);
+        std::ostringstream o;
+        for (std::size_t i = 0; i < count; ++i) {
+            long value = long_fields ? values[i] >> (i % 63)
+                                     : values[i] % (i % 2 ? 1000000 : 1000);
+            o << value << ',';
+        }
+        text = o.str();
+    }
+
+    return text;
+}
+
+std::size_t bulk(std::size_t iterations, bool long_fields)
+{
+    const std::string& in = text(long_fields);
+    std::vector<Checked> out(count);
+    std::vector<std::size_t> bad;
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        xxint::parse_fields(in.data(), in.data() + in.size(), ',',
+                            out.data(), out.size(), bad);
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+std::size_t one_at_a_time(std::size_t iterations, bool long_fields)
+{
+    const std::string& in = text(long_fields);
+    const char* last = in.data() + in.size();
+    std::vector<Checked> out(count);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        const char* p = in.data();
+        for (auto& each : out)
+            p = xxint::from_chars(p, last, each).ptr + 1;
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+std::size_t strtol_fields(std::size_t iterations, bool long_fields)
+{
+    const std::string& in = text(long_fields);
+    std::vector<long> out(count);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        const char* p = in.c_str();
+        for (auto& each : out) {
+            char* end;
+            each = std::strtol(p, &end, 10);
+            p = end + 1;
+        }
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+std::size_t stream_fields(std::size_t iterations, bool long_fields)
+{
+    std::vector<Checked> out(count);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        std::istringstream in(text(long_fields));
+        char comma;
+        for (auto& each : out) in >> each >> comma;
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+// The values of `text(long_fields)`, to format back.
+const std::vector<Checked>& values(bool long_fields)
+{
+    static std::vector<Checked> result[2];
+    std::vector<Checked>& values = result[long_fields];
+
+    if (values.empty()) {
+        const std::string& in = text(long_fields);
+        std::vector<std::size_t> bad;
+        values.resize(count);
+        xxint::parse_fields(in.data(), in.data() + in.size(), ',',
+                            values.data(), values.size(), bad);
+    }
+
+    return values;
+}
+
+std::size_t bulk_format(std::size_t iterations, bool long_fields)
+{
+    const std::vector<Checked>& in = values(long_fields);
+    std::vector<char> out(21 * count);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        auto result = xxint::format_fields(out.data(), out.data() + out.size(),
+                                           in.data(), in.size(), ',');
+        bench::keep(result.ptr);
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+std::size_t stream_format(std::size_t iterations, bool long_fields)
+{
+    const std::vector<Checked>& in = values(long_fields);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        std::ostringstream out;
+        for (const auto& each : in) out << each << ',';
+        bench::keep(out.str());
+    }
+
+    return count;
+}
+
+bench::Register r1("Fields short parse_fields",
+        [](std::size_t n) { return bulk(n, false); });
+bench::Register r2("Fields short from_chars each",
+        [](std::size_t n) { return one_at_a_time(n, false); });
+bench::Register r3("Fields short strtol",
+        [](std::size_t n) { return strtol_fields(n, false); });
+bench::Register r4("Fields short istream >>",
+        [](std::size_t n) { return stream_fields(n, false); });
+bench::Register r5("Fields long parse_fields",
+        [](std::size_t n) { return bulk(n, true); });
+bench::Register r6("Fields long from_chars each",
+        [](std::size_t n) { return one_at_a_time(n, true); });
+bench::Register r7("Fields long strtol",
+        [](std::size_t n) { return strtol_fields(n, true); });
+bench::Register r8("Fields long istream >>",
+        [](std::size_t n) { return stream_fields(n, true); });
+bench::Register r9("Fields short format_fields",
+        [](std::size_t n) { return bulk_format(n, false); });
+bench::Register r10("Fields short ostream <<",
+        [](std::size_t n) { return stream_format(n, false); });
+bench::Register r11("Fields long format_fields",
+        [](std::size_t n) { return bulk_format(n, true); });
+bench::Register r12("Fields long ostream <<",
+        [](std::size_t n) { return stream_format(n, true); });
+
+}
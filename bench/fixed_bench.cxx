@@ -0,0 +1,108 @@
+#include "bench.hxx"
+#include <fixed.hxx>
+
+#include <cstdint>
+
+using namespace xxint;
+
+namespace {
+
+using Q16  = Fixed<int32_t, 16>;
+using SQ16 = Fixed<int32_t, 16, policy::saturating>;
+
+const std::size_t count = 4096;
+
+// Raw values in [-8, 8), so that products stay in range.
+const std::vector<int32_t>& raws()
+{
+    static auto result = bench::random_ints<int32_t>(2 * count,
+                                                     -(8 << 16),
+                                                     (8 << 16) - 1);
+    return result;
+}
+
+template <class Q>
+std::vector<Q> fixed_inputs()
+{
+    std::vector<Q> result;
+    for (auto raw : raws())
+        result.push_back(Q::from_raw(raw));
+    return result;
+}
+
+std::vector<float> float_inputs()
+{
+    std::vector<float> result;
+    for (auto raw : raws())
+        result.push_back(raw / 65536.0f);
+    return result;
+}
+
+template <class Q>
+std::size_t fixed_mul(std::size_t iterations)
+{
+    static auto in = fixed_inputs<Q>();
+    std::vector<Q> out(count);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t j = 0; j < count; ++j)
+            out[j] = in[2 * j] * in[2 * j + 1];
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+template <class Q>
+std::size_t fixed_div(std::size_t iterations)
+{
+    static auto in = fixed_inputs<Q>();
+    std::vector<Q> out(count);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t j = 0; j < count; ++j) {
+            // Keeps quotients in range: |numerator| < 8, |divisor| >= 16.
+            out[j] = in[2 * j] / (in[2 * j + 1] + Q(24));
+        }
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+std::size_t float_mul(std::size_t iterations)
+{
+    static auto in = float_inputs();
+    std::vector<float> out(count);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t j = 0; j < count; ++j)
+            out[j] = in[2 * j] * in[2 * j + 1];
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+std::size_t float_div(std::size_t iterations)
+{
+    static auto in = float_inputs();
+    std::vector<float> out(count);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t j = 0; j < count; ++j)
+            out[j] = in[2 * j] / (in[2 * j + 1] + 24.0f);
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+bench::Register r1("Fixed<int32_t,16> multiply", fixed_mul<Q16>);
+bench::Register r2("Fixed<int32_t,16,saturating> multiply", fixed_mul<SQ16>);
+bench::Register r3("float multiply", float_mul);
+bench::Register r4("Fixed<int32_t,16> divide", fixed_div<Q16>);
+bench::Register r5("Fixed<int32_t,16,saturating> divide", fixed_div<SQ16>);
+bench::Register r6("float divide", float_div);
+
+}
@@ -0,0 +1,110 @@
+#include "bench.hxx"
+#include <Rational.hxx>
+
+#include <unordered_map>
+#include <unordered_set>
+
+using Rational = rational::Rational<>;
+
+namespace {
+
+const std::size_t count = std::size_t(1) << 21;
+
+// Fractions with many repeated values, as in an exact-ratio dedup table.
+const std::vector<Rational>& ratios()
+{
+    static std::vector<Rational> result = [] {
+        auto n = bench::random_ints<long>(count, -2000, 2000);
+        auto d = bench::random_ints<long>(count + 1, 1, 2000);
+        std::vector<Rational> values;
+        for (std::size_t i = 0; i < count; ++i)
+            values.emplace_back(n[i], d[i]);
+        return values;
+    }();
+    return result;
+}
+
+// The sort of hash written by hand for each key type.
+struct hand_rolled_hash
+{
+    std::size_t operator()(Rational r) const
+    {
+        return std::hash<long>()(r.numerator()) * 31
+               + std::hash<long>()(r.denominator());
+    }
+};
+
+template <class Hash>
+std::size_t rational_dedup(std::size_t iterations)
+{
+    auto const& in = ratios();
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        std::unordered_map<Rational, int, Hash> counts;
+        for (auto each : in) ++counts[each];
+        bench::keep(counts.size());
+    }
+
+    return count;
+}
+
+// Keys that share their low bits, such as scaled or aligned values.
+template <class T, class Hash>
+std::size_t strided_set(std::size_t iterations)
+{
+    auto in = bench::random_ints<long>(count, 0, 1L << 20);
+    for (auto& each : in) each <<= 16;
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        std::unordered_set<T, Hash> set;
+        set.max_load_factor(1);
+        for (auto each : in) set.insert(T(each));
+        bench::keep(set.size());
+    }
+
+    return count;
+}
+
+// A power-of-two table, as in open-addressing maps, with the hash's low
+// bits as the index; counts the probes for linear probing.
+template <class Hash>
+std::size_t probe_count(std::size_t iterations)
+{
+    auto in = bench::random_ints<long>(count, 0, 1L << 20);
+    for (auto& each : in) each <<= 16;
+    const std::size_t mask = (count << 1) - 1;
+    std::size_t probes = 0;
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        std::vector<long> table(mask + 1, -1);
+        probes = 0;
+        for (auto each : in) {
+            std::size_t slot = Hash()(each) & mask;
+            while (table[slot] != -1 && table[slot] != each) {
+                slot = (slot + 1) & mask;
+                ++probes;
+            }
+            table[slot] = each;
+        }
+        bench::keep(table);
+    }
+
+    bench::keep(probes);
+    return count;
+}
+
+bench::Register r1("unordered_map<Rational> dedup 2^21, std::hash",
+                   rational_dedup<std::hash<Rational>>);
+bench::Register r2("unordered_map<Rational> dedup 2^21, hand-rolled hash",
+                   rational_dedup<hand_rolled_hash>);
+bench::Register r3("unordered_set<Checked<long>> 2^21 strided, std::hash",
+                   strided_set<xxint::Checked<long>,
+                               std::hash<xxint::Checked<long>>>);
+bench::Register r4("unordered_set<long> 2^21 strided, std::hash",
+                   strided_set<long, std::hash<long>>);
+bench::Register r5("linear probing 2^21 strided, std::hash<Checked<long>>",
+                   probe_count<std::hash<xxint::Checked<long>>>);
+bench::Register r6("linear probing 2^21 strided, std::hash<long>",
+                   probe_count<std::hash<long>>);
+
+}
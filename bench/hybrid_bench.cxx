@@ -0,0 +1,80 @@
+#include "bench.hxx"
+#include <HybridRational.hxx>
+
+#include <gmpxx.h>
+
+using rational::HybridRational;
+
+namespace {
+
+const std::size_t count = 4096;
+
+// Random fractions, of which every `outlier_every`th has a denominator
+// near 2^62, so that adding it overflows `long`.
+std::vector<HybridRational> hybrids(std::size_t outlier_every)
+{
+    auto n = bench::random_ints<long>(count, -100000, 100000);
+    auto d = bench::random_ints<long>(count + 1, 1, 100000);
+    auto big = bench::random_ints<long>(count + 2, 1L << 61, 1L << 62);
+
+    std::vector<HybridRational> result;
+    for (std::size_t i = 0; i < count; ++i) {
+        bool outlier = outlier_every != 0 && i % outlier_every == 0;
+        result.emplace_back(n[i], outlier ? big[i] | 1 : d[i]);
+    }
+    return result;
+}
+
+// Adds neighbouring pairs.
+template <class T>
+std::size_t add_pairs(std::size_t iterations, const std::vector<T>& in)
+{
+    std::vector<T> out(count);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t j = 0; j < count; ++j)
+            out[j] = in[j] + in[count - 1 - j];
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+std::size_t rational_add(std::size_t iterations)
+{
+    std::vector<rational::Rational<>> in;
+    for (const auto& each : hybrids(0)) in.push_back(each.small());
+    return add_pairs(iterations, in);
+}
+
+std::size_t hybrid_add(std::size_t iterations)
+{
+    return add_pairs(iterations, hybrids(0));
+}
+
+std::size_t hybrid_add_outliers(std::size_t iterations)
+{
+    return add_pairs(iterations, hybrids(100));
+}
+
+std::size_t mpq_add(std::size_t iterations)
+{
+    std::vector<mpq_class> in;
+    for (const auto& each : hybrids(0)) in.push_back(each.to_mpq());
+    return add_pairs(iterations, in);
+}
+
+std::size_t mpq_add_outliers(std::size_t iterations)
+{
+    std::vector<mpq_class> in;
+    for (const auto& each : hybrids(100)) in.push_back(each.to_mpq());
+    return add_pairs(iterations, in);
+}
+
+bench::Register r1("Rational add (for HybridRational)", rational_add);
+bench::Register r2("HybridRational add", hybrid_add);
+bench::Register r3("HybridRational add, 2% overflowing", hybrid_add_outliers);
+bench::Register r4("mpq_class add", mpq_add);
+bench::Register r5("mpq_class add, 2% outliers", mpq_add_outliers);
+
+}
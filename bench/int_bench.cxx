@@ -0,0 +1,121 @@
+#include "bench.hxx"
+#include <xxint.hxx>
+
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+using Checked = xxint::Checked<long>;
+
+namespace {
+
+const std::size_t count = 4096;
+
+// Values of every length from 1 to 19 digits.
+const std::vector<long>& values()
+{
+    static std::vector<long> result = [] {
+        auto raw = bench::random_ints<long>(count, LONG_MIN, LONG_MAX);
+        for (std::size_t i = 0; i < count; ++i)
+            raw[i] >>= i % 63;
+        return raw;
+    }();
+    return result;
+}
+
+// The values, separated by spaces.
+const std::string& text()
+{
+    static std::string result = [] {
+        std::ostringstream o;
+        for (long each : values()) o << each << ' ';
+        return o.str();
+    }();
+    return result;
+}
+
+std::size_t checked_from_chars(std::size_t iterations)
+{
+    const char* last = text().data() + text().size();
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        const char* p = text().data();
+        Checked value;
+        while (p != last) {
+            p = xxint::from_chars(p, last, value).ptr + 1;
+            bench::keep(value);
+        }
+    }
+
+    return count;
+}
+
+std::size_t strtol_parse(std::size_t iterations)
+{
+    for (std::size_t i = 0; i < iterations; ++i) {
+        const char* p = text().c_str();
+        for (std::size_t j = 0; j < count; ++j) {
+            char* end;
+            bench::keep(std::strtol(p, &end, 10));
+            p = end;
+        }
+    }
+
+    return count;
+}
+
+template <class T>
+std::size_t stream_extract(std::size_t iterations)
+{
+    for (std::size_t i = 0; i < iterations; ++i) {
+        std::istringstream in(text());
+        T value;
+        for (std::size_t j = 0; j < count; ++j) {
+            in >> value;
+            bench::keep(value);
+        }
+    }
+
+    return count;
+}
+
+std::size_t checked_to_chars(std::size_t iterations)
+{
+    char buffer[24];
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (long each : values()) {
+            auto result = xxint::to_chars(buffer, buffer + sizeof buffer,
+                                          Checked(each));
+            bench::keep(result.ptr);
+            bench::keep(buffer);
+        }
+    }
+
+    return count;
+}
+
+std::size_t snprintf_format(std::size_t iterations)
+{
+    char buffer[24];
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (long each : values()) {
+            bench::keep(std::snprintf(buffer, sizeof buffer, "%ld", each));
+            bench::keep(buffer);
+        }
+    }
+
+    return count;
+}
+
+bench::Register r1("Checked from_chars", checked_from_chars);
+bench::Register r2("strtol", strtol_parse);
+bench::Register r3("istream >> long", stream_extract<long>);
+bench::Register r4("istream >> Checked", stream_extract<Checked>);
+bench::Register r5("Checked to_chars", checked_to_chars);
+bench::Register r6("snprintf %ld", snprintf_format);
+
+}
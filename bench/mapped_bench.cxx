@@ -0,0 +1,113 @@
+#include "bench.hxx"
+#include <mapped.hxx>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+
+#ifdef XXINT_HAS_MMAP
+
+using Narrow = xxint::Checked<int32_t>;
+
+namespace {
+
+const std::size_t count = 1 << 22;
+
+// A 32 MB column of int64_t values that fit in int32_t, as a column store
+// that widens everything on disk would write it. The file stays in the
+// page cache, so this measures mapping and conversion, not the disk.
+class Column_file
+{
+public:
+    Column_file()
+    {
+        int fd = ::mkstemp(path_);
+        auto values = bench::random_ints<int64_t>(count, INT32_MIN, INT32_MAX);
+        std::size_t bytes = values.size() * sizeof(int64_t);
+        if (fd < 0 || ::write(fd, values.data(), bytes) != ssize_t(bytes))
+            std::perror("mapped_bench");
+        ::close(fd);
+    }
+
+    ~Column_file() { std::remove(path_); }
+
+    const char* path() const { return path_; }
+
+private:
+    char path_[32] = "/tmp/xxint_bench_XXXXXX";
+};
+
+const char* path()
+{
+    static Column_file file;
+    return file.path();
+}
+
+const std::size_t buffer_size = 4096;
+
+// Map the file and convert it a buffer at a time.
+std::size_t mapped_read(std::size_t iterations)
+{
+    std::vector<Narrow> out(buffer_size);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        xxint::mapped_column<> column(path());
+        std::size_t first = 0;
+        while (std::size_t n = column.read(first, out.data(), out.size())) {
+            bench::keep(out);
+            first += n;
+        }
+    }
+
+    return count;
+}
+
+// Map the file and convert one value at a time.
+std::size_t mapped_each(std::size_t iterations)
+{
+    std::vector<Narrow> out(buffer_size);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        xxint::mapped_column<> column(path());
+        for (std::size_t first = 0; first < count; first += buffer_size) {
+            for (std::size_t j = 0; j < buffer_size; ++j)
+                out[j] = Narrow(column[first + j]);
+            bench::keep(out);
+        }
+    }
+
+    return count;
+}
+
+// The usual approach: read the whole file into a vector, then convert it.
+std::size_t stream_read(std::size_t iterations)
+{
+    for (std::size_t i = 0; i < iterations; ++i) {
+        std::ifstream in(path(), std::ios::binary);
+        std::vector<int64_t> raw(count);
+        in.read(reinterpret_cast<char*>(raw.data()),
+                std::streamsize(count * sizeof(int64_t)));
+
+        std::vector<Narrow> out;
+        out.reserve(count);
+        for (auto each : raw)
+            out.emplace_back(each);
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+// Throughput is of the file's bytes.
+bench::Register r1("Mapped read int64_t to Checked<int32_t>",
+                   mapped_read, sizeof(int64_t));
+bench::Register r2("Mapped convert each int64_t to Checked<int32_t>",
+                   mapped_each, sizeof(int64_t));
+bench::Register r3("Stream read int64_t to Checked<int32_t>",
+                   stream_read, sizeof(int64_t));
+
+}
+
+#endif // XXINT_HAS_MMAP
@@ -0,0 +1,191 @@
+#include "bench.hxx"
+#include <Matrix.hxx>
+
+#include <cstdint>
+#include <vector>
+
+using Rational = rational::Rational<>;
+using Matrix   = rational::Matrix<>;
+
+namespace {
+
+// An `n` by `n` system `a x = b` with a known integer solution, where `a =
+// L U` for random triangular `L` and `U` whose off-diagonal entries are -1,
+// 0 or 1 and whose diagonals have `twos` entries of 2 between them, so
+// that `det a = 2^twos`. Bareiss's intermediates are then at most about
+// `2^twos` times `4n`, and their products fit in `long` for `twos` up to
+// about 16.
+struct System
+{
+    Matrix a;
+    std::vector<xxint::Checked<long>> b;
+};
+
+System make_system(std::size_t n, std::size_t twos)
+{
+    auto off  = bench::random_ints<long>(2 * n * n, -1, 1);
+    auto diag = bench::random_ints<std::size_t>(twos, 0, 2 * n - 1);
+    auto x    = bench::random_ints<long>(n, -9, 9);
+
+    std::vector<long> l(n * n), u(n * n);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < i; ++j) {
+            l[i * n + j] = off[i * n + j];
+            u[j * n + i] = off[n * n + i * n + j];
+        }
+        l[i * n + i] = u[i * n + i] = 1;
+    }
+
+    // Repeated positions would give 4s; they just shift to the next one.
+    std::vector<bool> used(2 * n);
+    for (auto each : diag) {
+        while (used[each]) each = (each + 1) % (2 * n);
+        used[each] = true;
+        (each < n ? l : u)[(each % n) * (n + 1)] = 2;
+    }
+
+    System result{Matrix(n, n), std::vector<xxint::Checked<long>>(n)};
+    for (std::size_t i = 0; i < n; ++i) {
+        long sum = 0;
+        for (std::size_t j = 0; j < n; ++j) {
+            long entry = 0;
+            for (std::size_t k = 0; k <= std::min(i, j); ++k)
+                entry += l[i * n + k] * u[k * n + j];
+            result.a(i, j) = entry;
+            sum += entry * x[j];
+        }
+        result.b[i] = sum;
+    }
+
+    return result;
+}
+
+// Gaussian elimination over `Rational`, reducing after every operation,
+// which leaves the upper triangle in `m`, `n` by `n + 1` and stored by
+// rows, and returns the determinant.
+Rational rational_eliminate(std::vector<Rational>& m, std::size_t n)
+{
+    const std::size_t cols = n + 1;
+    Rational det(1);
+
+    for (std::size_t k = 0; k < n; ++k) {
+        std::size_t p = k;
+        while (p < n && m[p * cols + k] == Rational(0)) ++p;
+        if (p == n) return Rational(0);
+        if (p != k) {
+            std::swap_ranges(&m[p * cols], &m[p * cols] + cols, &m[k * cols]);
+            det = -det;
+        }
+
+        Rational pivot = m[k * cols + k];
+        det *= pivot;
+        for (std::size_t i = k + 1; i < n; ++i) {
+            Rational factor = m[i * cols + k] / pivot;
+            for (std::size_t j = k + 1; j < cols; ++j)
+                m[i * cols + j] -= factor * m[k * cols + j];
+            m[i * cols + k] = Rational(0);
+        }
+    }
+
+    return det;
+}
+
+std::vector<Rational> augmented(const System& s)
+{
+    std::size_t n = s.a.rows();
+    std::vector<Rational> m;
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j)
+            m.emplace_back(s.a(i, j).get());
+        m.emplace_back(s.b[i].get());
+    }
+    return m;
+}
+
+std::size_t bareiss_determinant(std::size_t iterations, const System& s)
+{
+    for (std::size_t i = 0; i < iterations; ++i)
+        bench::keep(rational::determinant(s.a));
+
+    return 1;
+}
+
+std::size_t rational_determinant(std::size_t iterations, const System& s)
+{
+    for (std::size_t i = 0; i < iterations; ++i) {
+        auto m = augmented(s);
+        bench::keep(rational_eliminate(m, s.a.rows()));
+    }
+
+    return 1;
+}
+
+std::size_t bareiss_solve(std::size_t iterations, const System& s)
+{
+    for (std::size_t i = 0; i < iterations; ++i)
+        bench::keep(rational::solve(s.a, s.b));
+
+    return 1;
+}
+
+std::size_t rational_solve(std::size_t iterations, const System& s)
+{
+    const std::size_t n = s.a.rows(), cols = n + 1;
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        auto m = augmented(s);
+        rational_eliminate(m, n);
+
+        std::vector<Rational> x(n);
+        for (std::size_t k = n; k-- > 0; ) {
+            Rational sum = m[k * cols + n];
+            for (std::size_t j = k + 1; j < n; ++j)
+                sum -= m[k * cols + j] * x[j];
+            x[k] = sum / m[k * cols + k];
+        }
+        bench::keep(x);
+    }
+
+    return 1;
+}
+
+// Registers each benchmark for each size, with `twos` chosen so that
+// Bareiss fits in `long`, or with `wide` so that it falls back to 128 bits.
+#define MATRIX_BENCH(n, twos)                                               \
+    const System& system_##n()                                              \
+    {                                                                       \
+        static System result = make_system(n, twos);                        \
+        return result;                                                      \
+    }                                                                       \
+    bench::Register det_bareiss_##n("Matrix determinant Bareiss " #n,       \
+            [](std::size_t i) { return bareiss_determinant(i, system_##n()); }); \
+    bench::Register det_rational_##n("Matrix determinant Rational " #n,     \
+            [](std::size_t i) { return rational_determinant(i, system_##n()); }); \
+    bench::Register solve_bareiss_##n("Matrix solve Bareiss " #n,           \
+            [](std::size_t i) { return bareiss_solve(i, system_##n()); });  \
+    bench::Register solve_rational_##n("Matrix solve Rational " #n,         \
+            [](std::size_t i) { return rational_solve(i, system_##n()); });
+
+MATRIX_BENCH(50, 16)
+MATRIX_BENCH(100, 16)
+MATRIX_BENCH(200, 16)
+MATRIX_BENCH(500, 16)
+
+#undef MATRIX_BENCH
+
+#ifdef XXINT_HAS_INT128
+// Minors up to 2^40 overflow `long` products, so every elimination is
+// redone in 128 bits.
+const System& wide_system()
+{
+    static System result = make_system(100, 40);
+    return result;
+}
+
+bench::Register det_wide("Matrix determinant Bareiss 100, 128-bit",
+        [](std::size_t i) { return bareiss_determinant(i, wide_system()); });
+bench::Register solve_wide("Matrix solve Bareiss 100, 128-bit",
+        [](std::size_t i) { return bareiss_solve(i, wide_system()); });
+#endif
+
+}
@@ -0,0 +1,106 @@
+#include "bench.hxx"
+#include <modular.hxx>
+
+#include <cstdint>
+
+using namespace xxint;
+
+namespace {
+
+const std::size_t count = 4096;
+
+template <class T, T M>
+const std::vector<T>& residues()
+{
+    static auto result = bench::random_ints<T>(count, 0, M - 1);
+    return result;
+}
+
+// A running product keeps every multiplication on the critical path, which
+// is what exponentiation and polynomial evaluation look like.
+template <class T, T M>
+std::size_t modular_product(std::size_t iterations)
+{
+    using Z = Modular<T, M>;
+    std::vector<Z> in;
+    for (auto each : residues<T, M>()) in.push_back(Z::from_residue(each));
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        Z total(1);
+        for (auto each : in) total *= each;
+        bench::keep(total);
+    }
+
+    return count;
+}
+
+template <class T, class Wide, T M>
+std::size_t naive_product(std::size_t iterations)
+{
+    auto const& in = residues<T, M>();
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        T total = 1;
+        for (auto each : in) total = T(Wide(total) * each % M);
+        bench::keep(total);
+    }
+
+    return count;
+}
+
+const uint64_t runtime_m = 998244353;
+
+// Read through a volatile so the compiler cannot fold the modulus.
+volatile uint64_t runtime_m_opaque = runtime_m;
+
+std::size_t dynamic_product(std::size_t iterations)
+{
+    Modulus<uint64_t> m(runtime_m_opaque);
+    std::vector<DynamicModular<uint64_t>> in;
+    for (auto each : residues<uint64_t, runtime_m>())
+        in.push_back(DynamicModular<uint64_t>::from_residue(m, each));
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        DynamicModular<uint64_t> total(m, 1);
+        for (auto each : in) total *= each;
+        bench::keep(total);
+    }
+
+    return count;
+}
+
+std::size_t runtime_naive_product(std::size_t iterations)
+{
+    uint64_t m = runtime_m_opaque;
+    auto const& in = residues<uint64_t, runtime_m>();
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        uint64_t total = 1;
+        for (auto each : in) total = total * each % m;
+        bench::keep(total);
+    }
+
+    return count;
+}
+
+const uint64_t mersenne61 = (1ULL << 61) - 1;
+const uint64_t even40 = (1ULL << 40) + 2;
+
+bench::Register r1("Modular<uint32_t,1e9+7> product",
+                   modular_product<uint32_t, 1000000007>);
+bench::Register r2("uint32_t % 1e9+7 product",
+                   naive_product<uint32_t, uint64_t, 1000000007>);
+bench::Register r3("DynamicModular<uint64_t> product", dynamic_product);
+bench::Register r4("uint64_t % runtime modulus product", runtime_naive_product);
+#ifdef XXINT_HAS_INT128
+bench::Register r5("Modular<uint64_t,2^61-1> product",
+                   modular_product<uint64_t, mersenne61>);
+bench::Register r6("uint128 % 2^61-1 product",
+                   naive_product<uint64_t, detail::uint128_t, mersenne61>);
+bench::Register r7("Modular<uint64_t,2^40+2> (Barrett) product",
+                   modular_product<uint64_t, even40>);
+bench::Register r8("uint128 % 2^40+2 product",
+                   naive_product<uint64_t, detail::uint128_t, even40>);
+#endif
+
+}
@@ -0,0 +1,91 @@
+#include "bench.hxx"
+#include <packed.hxx>
+
+#include <cstdint>
+#include <vector>
+
+using Checked = xxint::Checked<int16_t>;
+using Packed  = xxint::PackedArray<int16_t, 12>;
+
+namespace {
+
+const std::size_t count = 1 << 16;
+
+// Item sizes are those of the unpacked values, so that rates compare.
+
+const std::vector<int16_t>& raw()
+{
+    static auto result = bench::random_ints<int16_t>(count, -2048, 2047);
+    return result;
+}
+
+const Packed& packed()
+{
+    static Packed result = [] {
+        Packed a(count);
+        a.pack(0, raw().data(), count);
+        return a;
+    }();
+    return result;
+}
+
+std::size_t packed_get(std::size_t iterations)
+{
+    const Packed& a = packed();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        int64_t sum = 0;
+        for (std::size_t j = 0; j < count; ++j) sum += a[j].get();
+        bench::keep(sum);
+    }
+    return count;
+}
+
+std::size_t vector_get(std::size_t iterations)
+{
+    std::vector<Checked> a(raw().begin(), raw().end());
+    for (std::size_t i = 0; i < iterations; ++i) {
+        int64_t sum = 0;
+        for (std::size_t j = 0; j < count; ++j) sum += a[j].get();
+        bench::keep(sum);
+    }
+    return count;
+}
+
+std::size_t packed_unpack(std::size_t iterations)
+{
+    std::vector<Checked> out(count);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        packed().unpack(0, out.data(), count);
+        bench::keep(out);
+    }
+    return count;
+}
+
+std::size_t packed_set(std::size_t iterations)
+{
+    Packed a(count);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t j = 0; j < count; ++j) a.set(j, raw()[j]);
+        bench::keep(a.bytes());
+    }
+    return count;
+}
+
+std::size_t packed_pack(std::size_t iterations)
+{
+    Packed a(count);
+    for (std::size_t i = 0; i < iterations; ++i) {
+        a.pack(0, raw().data(), count);
+        bench::keep(a.bytes());
+    }
+    return count;
+}
+
+bench::Register r1("PackedArray get", packed_get, sizeof(int16_t));
+bench::Register r2("PackedArray vector<Checked> get", vector_get,
+                   sizeof(int16_t));
+bench::Register r3("PackedArray unpack", packed_unpack, sizeof(int16_t));
+bench::Register r4("PackedArray set", packed_set, sizeof(int16_t));
+bench::Register r5("PackedArray pack", packed_pack, sizeof(int16_t));
+
+}
@@ -0,0 +1,488 @@
+#include "bench.hxx"
+#include <gcd.hxx>
+#include <Rational.hxx>
+
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+using Rational = rational::Rational<>;
+
+namespace {
+
+const std::size_t count = 4096;
+
+const std::vector<long>& numerators()
+{
+    static auto result = bench::random_ints<long>(count, -100000, 100000);
+    return result;
+}
+
+const std::vector<long>& denominators()
+{
+    static auto result = bench::random_ints<long>(count, 1, 100000);
+    return result;
+}
+
+std::vector<Rational> rationals()
+{
+    std::vector<Rational> result;
+    for (std::size_t i = 0; i < count; ++i)
+        result.emplace_back(numerators()[i], denominators()[i]);
+    return result;
+}
+
+long euclid(long a, long b)
+{
+    while (a != 0) {
+        long c = a;
+        a = b % a;
+        b = c;
+    }
+
+    return b;
+}
+
+std::size_t gcd_xxint(std::size_t iterations)
+{
+    auto const& a = numerators();
+    auto const& b = denominators();
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t j = 0; j < count; ++j)
+            bench::keep(xxint::gcd(a[j], b[j]));
+    }
+
+    return count;
+}
+
+std::size_t gcd_euclid(std::size_t iterations)
+{
+    auto const& a = numerators();
+    auto const& b = denominators();
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t j = 0; j < count; ++j)
+            bench::keep(euclid(a[j], b[j]));
+    }
+
+    return count;
+}
+
+#ifdef XXINT_HAS_INT128
+using xxint::detail::uint128_t;
+
+const std::vector<uint128_t>& wide_pairs()
+{
+    static std::vector<uint128_t> result = [] {
+        auto lo = bench::random_ints<uint64_t>(2 * count, 0, UINT64_MAX >> 1);
+        auto hi = bench::random_ints<uint64_t>(2 * count + 1, 0, UINT64_MAX >> 1);
+        std::vector<uint128_t> wide;
+        for (std::size_t i = 0; i < 2 * count; ++i)
+            wide.push_back(uint128_t(hi[i]) << 64 | lo[i]);
+        return wide;
+    }();
+    return result;
+}
+
+std::size_t gcd_lehmer_128(std::size_t iterations)
+{
+    auto const& in = wide_pairs();
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t j = 0; j < count; ++j)
+            bench::keep(xxint::gcd(in[2 * j], in[2 * j + 1]));
+    }
+
+    return count;
+}
+
+std::size_t gcd_binary_128(std::size_t iterations)
+{
+    auto const& in = wide_pairs();
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t j = 0; j < count; ++j)
+            bench::keep(xxint::detail::binary_gcd(in[2 * j], in[2 * j + 1]));
+    }
+
+    return count;
+}
+#endif
+
+std::size_t rational_construct(std::size_t iterations)
+{
+    auto const& n = numerators();
+    auto const& d = denominators();
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t j = 0; j < count; ++j)
+            bench::keep(Rational(n[j], d[j]));
+    }
+
+    return count;
+}
+
+std::size_t rational_add(std::size_t iterations)
+{
+    auto in = rationals();
+    std::vector<Rational> out(count);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t j = 0; j < count; ++j)
+            out[j] = in[j] + in[count - 1 - j];
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+std::size_t rational_mul(std::size_t iterations)
+{
+    auto in = rationals();
+    std::vector<Rational> out(count);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t j = 0; j < count; ++j)
+            out[j] = in[j] * in[count - 1 - j];
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+std::size_t rational_integer_add(std::size_t iterations)
+{
+    std::vector<Rational> in, out(count);
+    for (auto n : numerators()) in.emplace_back(n);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t j = 0; j < count; ++j)
+            out[j] = in[j] + in[count - 1 - j];
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+std::size_t rational_same_den_add(std::size_t iterations)
+{
+    std::vector<Rational> in, out(count);
+    for (auto n : numerators()) in.emplace_back(n, 360);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t j = 0; j < count; ++j)
+            out[j] = in[j] + in[count - 1 - j];
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+std::size_t rational_increment(std::size_t iterations)
+{
+    auto in = rationals();
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (auto& each : in) ++each;
+        bench::keep(in);
+    }
+
+    return count;
+}
+
+std::size_t rational32_add(std::size_t iterations)
+{
+    using R32 = rational::Rational<xxint::Checked<int32_t>>;
+
+    // Operands small enough that the sums fit in 32 bits.
+    std::vector<R32> in, out(count);
+    for (std::size_t i = 0; i < count; ++i)
+        in.emplace_back(int32_t(numerators()[i] / 100),
+                        int32_t(denominators()[i] % 1000 + 1));
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t j = 0; j < count; ++j)
+            out[j] = in[j] + in[count - 1 - j];
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+// Sums of unit fractions 1/k for k in [1, 40], whose denominators grow
+// to near the limit of `long`, so the gcds run on large operands.
+std::size_t rational_harmonic(std::size_t iterations)
+{
+    const long terms = 40;
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        Rational sum;
+        for (long k = 1; k <= terms; ++k)
+            sum += Rational(1, k);
+        bench::keep(sum);
+    }
+
+    return terms;
+}
+
+std::size_t accumulator_harmonic(std::size_t iterations)
+{
+    const long terms = 40;
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        rational::RationalAccumulator<> sum;
+        for (long k = 1; k <= terms; ++k)
+            sum += Rational(1, k);
+        bench::keep(sum.total());
+    }
+
+    return terms;
+}
+
+// Amounts in units such as halves, thirds, quarters and twelfths.
+std::vector<Rational> small_denominator_rationals()
+{
+    auto d = bench::random_ints<long>(count + 2, 1, 12);
+    std::vector<Rational> result;
+    for (std::size_t i = 0; i < count; ++i)
+        result.emplace_back(numerators()[i], d[i]);
+    return result;
+}
+
+std::size_t rational_small_denominator_sum(std::size_t iterations)
+{
+    auto in = small_denominator_rationals();
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        Rational sum;
+        for (auto each : in) sum += each;
+        bench::keep(sum);
+    }
+
+    return count;
+}
+
+std::size_t accumulator_small_denominator_sum(std::size_t iterations)
+{
+    auto in = small_denominator_rationals();
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        rational::RationalAccumulator<> sum;
+        for (auto each : in) sum += each;
+        bench::keep(sum.total());
+    }
+
+    return count;
+}
+
+const std::vector<std::string>& rational_texts()
+{
+    static std::vector<std::string> result = [] {
+        std::vector<std::string> strings;
+        char buffer[48];
+        for (auto each : rationals()) {
+            auto r = rational::to_chars(buffer, buffer + sizeof buffer, each);
+            strings.emplace_back(buffer, r.ptr);
+        }
+        return strings;
+    }();
+    return result;
+}
+
+std::size_t rational_to_chars(std::size_t iterations)
+{
+    auto in = rationals();
+    char buffer[48];
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (auto each : in) {
+            rational::to_chars(buffer, buffer + sizeof buffer, each);
+            bench::keep(buffer);
+        }
+    }
+
+    return count;
+}
+
+std::size_t rational_ostream(std::size_t iterations)
+{
+    auto in = rationals();
+    std::ostringstream os;
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (auto each : in) {
+            os.str(std::string());
+            os << each.numerator() << '/' << each.denominator();
+            bench::keep(os);
+        }
+    }
+
+    return count;
+}
+
+std::size_t rational_from_chars(std::size_t iterations)
+{
+    auto const& in = rational_texts();
+    std::vector<Rational> out(count);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t j = 0; j < count; ++j)
+            rational::from_chars(in[j].data(), in[j].data() + in[j].size(),
+                                 out[j]);
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+std::size_t rational_istream(std::size_t iterations)
+{
+    auto const& in = rational_texts();
+    std::vector<Rational> out(count);
+    std::istringstream is;
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t j = 0; j < count; ++j) {
+            long n, d = 1;
+            is.clear();
+            is.str(in[j]);
+            is >> n;
+            if (is.peek() == '/') is.ignore() >> d;
+            out[j] = Rational(n, d);
+        }
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+std::size_t rational_to_double(std::size_t iterations)
+{
+    auto in = rationals();
+    std::vector<double> out(count);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t j = 0; j < count; ++j)
+            out[j] = to_double(in[j]);
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+// Parts above 2^53, which take the exact division path.
+std::size_t rational_to_double_large(std::size_t iterations)
+{
+    auto n = bench::random_ints<long>(count + 3, -(1L << 62), 1L << 62);
+    auto d = bench::random_ints<long>(count + 4, 1L << 54, 1L << 62);
+    std::vector<Rational> in;
+    for (std::size_t j = 0; j < count; ++j) in.emplace_back(n[j], d[j]);
+    std::vector<double> out(count);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t j = 0; j < count; ++j)
+            out[j] = to_double(in[j]);
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+std::size_t rational_from_double(std::size_t iterations)
+{
+    std::vector<double> in;
+    for (auto each : rationals()) in.push_back(to_double(each));
+    std::vector<Rational> out(count);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t j = 0; j < count; ++j)
+            out[j] = rational::from_double(in[j], 1000000);
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+const std::size_t sort_count = std::size_t(1) << 20;
+
+const std::vector<Rational>& unsorted()
+{
+    static std::vector<Rational> result = [] {
+        auto n = bench::random_ints<long>(sort_count, -1000000, 1000000);
+        auto d = bench::random_ints<long>(sort_count + 1, 1, 1000000);
+        std::vector<Rational> values;
+        for (std::size_t i = 0; i < sort_count; ++i)
+            values.emplace_back(n[i], d[i]);
+        return values;
+    }();
+    return result;
+}
+
+template <class Less>
+std::size_t sort_with(std::size_t iterations, Less less)
+{
+    for (std::size_t i = 0; i < iterations; ++i) {
+        auto values = unsorted();
+        std::sort(values.begin(), values.end(), less);
+        bench::keep(values.front());
+    }
+
+    return sort_count;
+}
+
+std::size_t rational_sort(std::size_t iterations)
+{
+    return sort_with(iterations, std::less<Rational>());
+}
+
+// What operator< used to do; correct here only because the values are small.
+std::size_t unchecked_sort(std::size_t iterations)
+{
+    return sort_with(iterations, [](Rational a, Rational b) {
+        return a.numerator() * b.denominator() < b.numerator() * a.denominator();
+    });
+}
+
+std::size_t double_sort(std::size_t iterations)
+{
+    return sort_with(iterations, [](Rational a, Rational b) {
+        return to_double(a) < to_double(b);
+    });
+}
+
+bench::Register r1("xxint::gcd long", gcd_xxint);
+bench::Register r2("Euclid % gcd long", gcd_euclid);
+#ifdef XXINT_HAS_INT128
+bench::Register r3("xxint::gcd uint128 (Lehmer)", gcd_lehmer_128);
+bench::Register r4("binary gcd uint128", gcd_binary_128);
+#endif
+bench::Register r5("Rational construct", rational_construct);
+bench::Register r6("Rational add", rational_add);
+bench::Register r7("Rational multiply", rational_mul);
+bench::Register r8("Rational harmonic sum", rational_harmonic);
+bench::Register r16("RationalAccumulator harmonic sum", accumulator_harmonic);
+bench::Register r17("Rational small-denominator sum",
+                    rational_small_denominator_sum);
+bench::Register r18("RationalAccumulator small-denominator sum",
+                    accumulator_small_denominator_sum);
+bench::Register r9("Rational<int32_t> add", rational32_add);
+bench::Register r13("Rational integer add", rational_integer_add);
+bench::Register r14("Rational same-denominator add", rational_same_den_add);
+bench::Register r15("Rational ++", rational_increment);
+bench::Register r19("Rational to_chars", rational_to_chars);
+bench::Register r20("Rational via ostream <<", rational_ostream);
+bench::Register r21("Rational from_chars", rational_from_chars);
+bench::Register r22("Rational via istream >>", rational_istream);
+bench::Register r23("Rational to_double", rational_to_double);
+bench::Register r24("Rational to_double, parts above 2^53",
+                    rational_to_double_large);
+bench::Register r25("Rational from_double, denominator <= 10^6",
+                    rational_from_double);
+bench::Register r10("Rational sort 2^20", rational_sort);
+bench::Register r11("unchecked long cross-multiply sort 2^20", unchecked_sort);
+bench::Register r12("to_double sort 2^20 (inexact)", double_sort);
+
+}
@@ -0,0 +1,161 @@
+#include "bench.hxx"
+#include <varint.hxx>
+
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+using Checked = xxint::Checked<long>;
+
+namespace {
+
+const std::size_t count = 1 << 16;
+
+// Counters that mostly fit in one byte, or values of every bit length, in
+// random order so that the lengths cannot be predicted.
+const std::vector<Checked>& values(bool long_values)
+{
+    static std::vector<Checked> result[2];
+    std::vector<Checked>& values = result[long_values];
+
+    if (values.empty()) {
+        auto raw    = bench::random_ints<long>(count, LONG_MIN, LONG_MAX);
+        auto shifts = bench::random_ints<int>(count, 0, 62);
+        for (std::size_t i = 0; i < count; ++i) {
+            long small = raw[i] % (shifts[i] % 8 ? 64 : 10000);
+            values.emplace_back(long_values ? raw[i] >> shifts[i] : small);
+        }
+    }
+
+    return values;
+}
+
+const std::vector<uint8_t>& bytes(bool long_values)
+{
+    static std::vector<uint8_t> result[2];
+    std::vector<uint8_t>& bytes = result[long_values];
+
+    if (bytes.empty()) {
+        const auto& in = values(long_values);
+        bytes.resize(10 * count);
+        auto end = xxint::encode_varints(bytes.data(),
+                                         bytes.data() + bytes.size(),
+                                         in.data(), in.size()).ptr;
+        bytes.resize(std::size_t(end - bytes.data()));
+    }
+
+    return bytes;
+}
+
+std::size_t bulk_encode(std::size_t iterations, bool long_values)
+{
+    const auto& in = values(long_values);
+    std::vector<uint8_t> out(10 * count);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        auto result = xxint::encode_varints(out.data(), out.data() + out.size(),
+                                            in.data(), in.size());
+        bench::keep(result.ptr);
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+std::size_t each_encode(std::size_t iterations, bool long_values)
+{
+    const auto& in = values(long_values);
+    std::vector<uint8_t> out(10 * count);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        uint8_t* p = out.data();
+        for (auto each : in)
+            p = xxint::encode_varint(p, out.data() + out.size(), each).ptr;
+        bench::keep(p);
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+template <class T>
+std::size_t bulk_decode(std::size_t iterations, bool long_values)
+{
+    const auto& in = bytes(long_values);
+    std::vector<T> out(count);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        xxint::decode_varints(in.data(), in.data() + in.size(),
+                              out.data(), out.size());
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+std::size_t each_decode(std::size_t iterations, bool long_values)
+{
+    const auto& in = bytes(long_values);
+    std::vector<Checked> out(count);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        const uint8_t* p = in.data();
+        for (auto& each : out)
+            p = xxint::decode_varint(p, in.data() + in.size(), each).ptr;
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+// The usual hand-written loop, which neither bounds the input nor checks
+// the value.
+std::size_t unchecked_decode(std::size_t iterations, bool long_values)
+{
+    const auto& in = bytes(long_values);
+    std::vector<long> out(count);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        const uint8_t* p = in.data();
+        for (auto& each : out) {
+            uint64_t value = 0;
+            for (int shift = 0; ; shift += 7) {
+                value |= uint64_t(*p & 0x7F) << shift;
+                if (*p++ < 0x80) break;
+            }
+            each = long(value >> 1) ^ -long(value & 1);
+        }
+        bench::keep(out);
+    }
+
+    return count;
+}
+
+using Narrow = xxint::Saturating<int32_t>;
+
+bench::Register r1("Varint short encode_varints",
+        [](std::size_t n) { return bulk_encode(n, false); });
+bench::Register r2("Varint short encode_varint each",
+        [](std::size_t n) { return each_encode(n, false); });
+bench::Register r3("Varint short decode_varints",
+        [](std::size_t n) { return bulk_decode<Checked>(n, false); });
+bench::Register r4("Varint short decode_varints to Saturating<int32_t>",
+        [](std::size_t n) { return bulk_decode<Narrow>(n, false); });
+bench::Register r5("Varint short decode_varint each",
+        [](std::size_t n) { return each_decode(n, false); });
+bench::Register r6("Varint short unchecked loop",
+        [](std::size_t n) { return unchecked_decode(n, false); });
+bench::Register r7("Varint long encode_varints",
+        [](std::size_t n) { return bulk_encode(n, true); });
+bench::Register r8("Varint long encode_varint each",
+        [](std::size_t n) { return each_encode(n, true); });
+bench::Register r9("Varint long decode_varints",
+        [](std::size_t n) { return bulk_decode<Checked>(n, true); });
+bench::Register r10("Varint long decode_varints to Saturating<int32_t>",
+        [](std::size_t n) { return bulk_decode<Narrow>(n, true); });
+bench::Register r11("Varint long decode_varint each",
+        [](std::size_t n) { return each_decode(n, true); });
+bench::Register r12("Varint long unchecked loop",
+        [](std::size_t n) { return unchecked_decode(n, true); });
+
+}
@@ -0,0 +1,106 @@
+#include "bench.hxx"
+#include <vector.hxx>
+
+#include <cstdint>
+#include <vector>
+
+using Checked = xxint::Checked<int32_t>;
+using Column  = xxint::CheckedVector<int32_t>;
+
+namespace {
+
+const std::size_t count = 1 << 14;
+
+// Values far from overflow, as most columns are.
+const std::vector<int32_t>& raw()
+{
+    static auto result = bench::random_ints<int32_t>(count, -1000000, 1000000);
+    return result;
+}
+
+// Each iteration adds and then subtracts, so that values stay in range.
+std::size_t column_scalar(std::size_t iterations)
+{
+    Column column;
+    for (auto each : raw()) column.push_back(each);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        column += 3;
+        column -= 3;
+        bench::keep(column.data());
+    }
+
+    return 2 * count;
+}
+
+std::size_t vector_scalar(std::size_t iterations)
+{
+    std::vector<Checked> column(raw().begin(), raw().end());
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (auto& each : column) each = each + 3;
+        for (auto& each : column) each = each - 3;
+        bench::keep(column);
+    }
+
+    return 2 * count;
+}
+
+std::size_t unchecked_scalar(std::size_t iterations)
+{
+    std::vector<int32_t> column(raw());
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (auto& each : column) each += 3;
+        for (auto& each : column) each -= 3;
+        bench::keep(column);
+    }
+
+    return 2 * count;
+}
+
+std::size_t column_elementwise(std::size_t iterations)
+{
+    Column column, other;
+    for (auto each : raw()) {
+        column.push_back(each);
+        other.push_back(each / 2);
+    }
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        column += other;
+        column -= other;
+        bench::keep(column.data());
+    }
+
+    return 2 * count;
+}
+
+std::size_t vector_elementwise(std::size_t iterations)
+{
+    std::vector<Checked> column(raw().begin(), raw().end()), other;
+    for (auto each : raw()) other.emplace_back(each / 2);
+
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t j = 0; j < count; ++j)
+            column[j] = column[j] + other[j];
+        for (std::size_t j = 0; j < count; ++j)
+            column[j] = column[j] - other[j];
+        bench::keep(column);
+    }
+
+    return 2 * count;
+}
+
+bench::Register r1("CheckedVector += scalar", column_scalar,
+                   sizeof(int32_t));
+bench::Register r2("CheckedVector vector<Checked> + scalar", vector_scalar,
+                   sizeof(int32_t));
+bench::Register r3("CheckedVector unchecked + scalar", unchecked_scalar,
+                   sizeof(int32_t));
+bench::Register r4("CheckedVector += CheckedVector", column_elementwise,
+                   sizeof(int32_t));
+bench::Register r5("CheckedVector vector<Checked> + vector<Checked>",
+                   vector_elementwise, sizeof(int32_t));
+
+}
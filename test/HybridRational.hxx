@@ -0,0 +1,351 @@
+#pragma once
+
+#include "Rational.hxx"
+#include <gmpxx.h>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+
+namespace rational {
+
+// A rational number that is a `Rational<>` while it fits, and switches to
+// GMP's arbitrary-precision `mpq_class` when an operation would overflow.
+// Once a result fits in a `Rational<>` again, it switches back.
+//
+// Operations on two small values whose parts fit in 32 bits cost a
+// `Rational<>` operation and a few tests. With larger parts, sums and
+// products are computed exactly in the double-width type and reduced
+// once, so overflow is found without an exception, and only results that
+// do not fit pay for GMP.
+class HybridRational
+{
+public:
+    using small_t  = Rational<>;
+    using int_type = small_t::int_type;
+
+    // Constructs the rational representing 0
+    HybridRational()
+    { }
+
+    // Constructs the rational representing `n`
+    HybridRational(int_type n) : small_(n)
+    { }
+
+    // Constructs the rational representing `n/d`; throws
+    // std::overflow_error if `d` is 0.
+    HybridRational(int_type n, int_type d);
+
+    // Converts from a `Rational<>`.
+    HybridRational(small_t r) : small_(r)
+    { }
+
+    // Converts from GMP, which must not have a zero denominator.
+    explicit HybridRational(const mpq_class&);
+
+    HybridRational(const HybridRational&);
+    HybridRational(HybridRational&&) = default;
+    HybridRational& operator=(const HybridRational&);
+    HybridRational& operator=(HybridRational&&) = default;
+
+    // Whether the value is held as a `Rational<>`.
+    bool is_small() const { return !big_; }
+
+    // Gets the value as a `Rational<>`.
+    //
+    // PRECONDITION: `is_small()`
+    small_t small() const { return small_; }
+
+    // Gets the value as a GMP rational.
+    mpq_class to_mpq() const;
+
+    // Negation -r
+    HybridRational operator-() const;
+
+    // Reciprocal 1/r; throws std::overflow_error if r is 0.
+    HybridRational reciprocal() const;
+
+    // Multiplication.
+    HybridRational operator*(const HybridRational&) const;
+
+    // Addition.
+    HybridRational operator+(const HybridRational&) const;
+
+    // Compares by value.
+    bool operator==(const HybridRational&) const;
+    bool operator<(const HybridRational&) const;
+
+    friend std::ostream& operator<<(std::ostream&, const HybridRational&);
+
+private:
+    small_t small_;
+    std::unique_ptr<mpq_class> big_;
+    // invariant:
+    //   big_ is null exactly when the value fits in small_t, so equal
+    //   values always have the same representation
+
+    using wide_t = xxint::detail::wider_t<int_type>;
+    static_assert(!std::is_void<wide_t>::value,
+                  "HybridRational: needs a double-width integer type");
+
+    // Whether sums and products with `r` certainly fit in `small_t`.
+    static bool short_(small_t r);
+
+    // Reduces `n/d`, where `d > 0`, to a small or a big value.
+    static HybridRational from_wide_(wide_t n, wide_t d);
+
+    // Applies `small_op` if both operands are small and short, `wide_op`
+    // if both are small, and otherwise `big_op`.
+    template <class SmallOp, class WideOp, class BigOp>
+    HybridRational apply_(const HybridRational&,
+                          SmallOp, WideOp, BigOp) const;
+
+    // Applies `small_op` if the operand is small, or `big_op` if it is not
+    // or `small_op` overflows.
+    template <class SmallOp, class BigOp>
+    HybridRational apply_(SmallOp, BigOp) const;
+};
+
+bool operator!=(const HybridRational&, const HybridRational&);
+bool operator<=(const HybridRational&, const HybridRational&);
+bool operator>(const HybridRational&, const HybridRational&);
+bool operator>=(const HybridRational&, const HybridRational&);
+
+HybridRational operator-(const HybridRational&, const HybridRational&);
+HybridRational operator/(const HybridRational&, const HybridRational&);
+
+HybridRational& operator+=(HybridRational&, const HybridRational&);
+HybridRational& operator-=(HybridRational&, const HybridRational&);
+HybridRational& operator*=(HybridRational&, const HybridRational&);
+HybridRational& operator/=(HybridRational&, const HybridRational&);
+
+/*
+ * Implementation
+ */
+
+inline HybridRational::HybridRational(int_type n, int_type d)
+{
+    // Only `LONG_MIN` over a negative denominator can overflow.
+    try {
+        small_ = small_t(n, d);
+    } catch (xxint::overflow_too_large&) {
+        *this = HybridRational(mpq_class(mpz_class(n), mpz_class(d)));
+    }
+}
+
+inline HybridRational::HybridRational(const mpq_class& q)
+{
+    mpq_class value(q);
+    value.canonicalize();
+
+    const mpz_class& num = value.get_num();
+    const mpz_class& den = value.get_den();
+
+    if (num.fits_slong_p() && den.fits_slong_p())
+        small_ = small_t(num.get_si(), den.get_si());
+    else
+        big_.reset(new mpq_class(std::move(value)));
+}
+
+inline HybridRational::HybridRational(const HybridRational& other)
+        : small_(other.small_)
+        , big_(other.big_ ? new mpq_class(*other.big_) : nullptr)
+{ }
+
+inline HybridRational& HybridRational::operator=(const HybridRational& other)
+{
+    small_ = other.small_;
+    big_.reset(other.big_ ? new mpq_class(*other.big_) : nullptr);
+    return *this;
+}
+
+inline mpq_class HybridRational::to_mpq() const
+{
+    if (big_) return *big_;
+
+    // Both parts are already in lowest terms.
+    mpq_class result;
+    mpz_set_si(result.get_num_mpz_t(), small_.numerator());
+    mpz_set_si(result.get_den_mpz_t(), small_.denominator());
+    return result;
+}
+
+inline bool HybridRational::short_(small_t r)
+{
+    const int_type limit = int_type(1) << 31;
+    return uint64_t(r.numerator()) + uint64_t(limit) < uint64_t(2 * limit)
+           && r.denominator() < limit;
+}
+
+inline HybridRational HybridRational::from_wide_(wide_t n, wide_t d)
+{
+    auto divisor = static_cast<wide_t>(xxint::gcd(n, d));
+    n /= divisor;
+    d /= divisor;
+
+    HybridRational result;
+
+    if (n == int_type(n) && d == int_type(d)) {
+        result.small_.num_ = int_type(n);
+        result.small_.den_ = int_type(d);
+    } else {
+        // Each part goes in as its 64-bit words, least significant first.
+        auto set = [](mpz_class& z, wide_t w) {
+            auto magnitude = xxint::detail::magnitude(w);
+            uint64_t words[] = {uint64_t(magnitude), uint64_t(magnitude >> 64)};
+            mpz_import(z.get_mpz_t(), 2, -1, sizeof words[0], 0, 0, words);
+            if (w < 0) z = -z;
+        };
+        result.big_.reset(new mpq_class);
+        set(result.big_->get_num(), n);
+        set(result.big_->get_den(), d);
+    }
+
+    return result;
+}
+
+template <class SmallOp, class WideOp, class BigOp>
+HybridRational HybridRational::apply_(const HybridRational& other,
+                                      SmallOp small_op,
+                                      WideOp wide_op,
+                                      BigOp big_op) const
+{
+    if (is_small() && other.is_small()) {
+        if (short_(small_) && short_(other.small_))
+            return small_op(small_, other.small_);
+
+        wide_t n, d;
+        wide_op(small_, other.small_, n, d);
+        return from_wide_(n, d);
+    }
+
+    return HybridRational(mpq_class(big_op(to_mpq(), other.to_mpq())));
+}
+
+template <class SmallOp, class BigOp>
+HybridRational HybridRational::apply_(SmallOp small_op, BigOp big_op) const
+{
+    if (is_small()) {
+        // Division by zero is not an overflow, so it is not caught.
+        try {
+            return small_op(small_);
+        } catch (xxint::overflow_too_large&) {
+        } catch (xxint::overflow_too_small&) {
+        }
+    }
+
+    return HybridRational(mpq_class(big_op(to_mpq())));
+}
+
+inline HybridRational HybridRational::operator-() const
+{
+    return apply_([](small_t a) { return -a; },
+                  [](const mpq_class& a) { return -a; });
+}
+
+inline HybridRational HybridRational::reciprocal() const
+{
+    if (is_small() && small_.numerator() == 0)
+        throw std::overflow_error("HybridRational: reciprocal of 0");
+
+    return apply_([](small_t a) { return a.reciprocal(); },
+                  [](const mpq_class& a) { return 1 / a; });
+}
+
+inline HybridRational
+HybridRational::operator*(const HybridRational& other) const
+{
+    return apply_(other,
+                  [](small_t a, small_t b) { return a * b; },
+                  [](small_t a, small_t b, wide_t& n, wide_t& d) {
+                      n = wide_t(a.numerator()) * b.numerator();
+                      d = wide_t(a.denominator()) * b.denominator();
+                  },
+                  [](const mpq_class& a, const mpq_class& b) { return a * b; });
+}
+
+inline HybridRational
+HybridRational::operator+(const HybridRational& other) const
+{
+    return apply_(other,
+                  [](small_t a, small_t b) { return a + b; },
+                  [](small_t a, small_t b, wide_t& n, wide_t& d) {
+                      n = wide_t(a.numerator()) * b.denominator()
+                          + wide_t(b.numerator()) * a.denominator();
+                      d = wide_t(a.denominator()) * b.denominator();
+                  },
+                  [](const mpq_class& a, const mpq_class& b) { return a + b; });
+}
+
+inline bool HybridRational::operator==(const HybridRational& other) const
+{
+    if (is_small() && other.is_small()) return small_ == other.small_;
+    if (big_ && other.big_) return *big_ == *other.big_;
+    return false;
+}
+
+inline bool HybridRational::operator<(const HybridRational& other) const
+{
+    if (is_small() && other.is_small()) return small_ < other.small_;
+    return to_mpq() < other.to_mpq();
+}
+
+inline std::ostream& operator<<(std::ostream& o, const HybridRational& r)
+{
+    if (r.big_) return o << *r.big_;
+    return o << r.small_;
+}
+
+inline bool operator!=(const HybridRational& a, const HybridRational& b)
+{
+    return !(a == b);
+}
+
+inline bool operator<=(const HybridRational& a, const HybridRational& b)
+{
+    return !(b < a);
+}
+
+inline bool operator>(const HybridRational& a, const HybridRational& b)
+{
+    return b < a;
+}
+
+inline bool operator>=(const HybridRational& a, const HybridRational& b)
+{
+    return b <= a;
+}
+
+inline HybridRational operator-(const HybridRational& a,
+                                const HybridRational& b)
+{
+    return a + -b;
+}
+
+inline HybridRational operator/(const HybridRational& a,
+                                const HybridRational& b)
+{
+    return a * b.reciprocal();
+}
+
+inline HybridRational& operator+=(HybridRational& a, const HybridRational& b)
+{
+    return a = a + b;
+}
+
+inline HybridRational& operator-=(HybridRational& a, const HybridRational& b)
+{
+    return a = a - b;
+}
+
+inline HybridRational& operator*=(HybridRational& a, const HybridRational& b)
+{
+    return a = a * b;
+}
+
+inline HybridRational& operator/=(HybridRational& a, const HybridRational& b)
+{
+    return a = a / b;
+}
+
+}
@@ -0,0 +1,354 @@
+#pragma once
+
+#include "Rational.hxx"
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rational {
+
+// A dense matrix of integers stored as `Repr`, a `Checked` integer type,
+// by rows.
+template <class Repr = xxint::Checked<long>>
+class Matrix
+{
+public:
+    using repr_t   = Repr;
+    using int_type = typename detail::repr_traits<Repr>::int_type;
+
+    // Constructs a `rows` by `cols` matrix of zeros.
+    Matrix(std::size_t rows, std::size_t cols)
+            : rows_(rows), cols_(cols), entries_(rows * cols)
+    { }
+
+    // Constructs a matrix from its rows; throws std::invalid_argument if
+    // they differ in length.
+    Matrix(std::initializer_list<std::initializer_list<int_type>>);
+
+    std::size_t rows() const { return rows_; }
+    std::size_t cols() const { return cols_; }
+
+    repr_t& operator()(std::size_t i, std::size_t j)
+    {
+        return entries_[i * cols_ + j];
+    }
+
+    repr_t operator()(std::size_t i, std::size_t j) const
+    {
+        return entries_[i * cols_ + j];
+    }
+
+private:
+    std::size_t rows_, cols_;
+    std::vector<repr_t> entries_;
+};
+
+// The determinant of the square matrix `a`; throws std::invalid_argument
+// if `a` is not square. A result that does not fit is handled by the
+// policy of `Repr`.
+template <class Repr>
+Rational<Repr> determinant(const Matrix<Repr>& a);
+
+// The solution `x` of `a x = b`, for square `a`. Throws
+// std::invalid_argument if the sizes do not match and std::domain_error if
+// `a` is singular. Parts of the solution that do not fit are handled by
+// the policy of `Repr`.
+template <class Repr>
+std::vector<Rational<Repr>> solve(const Matrix<Repr>& a,
+                                  const std::vector<Repr>& b);
+
+// The rank of `a`.
+template <class Repr>
+std::size_t rank(const Matrix<Repr>& a);
+
+// All three use Bareiss's fraction-free elimination (Bareiss 1968): after
+// step `k` every remaining entry is a (k+1)-by-(k+1) minor of the input,
+// so entries stay integers, each division is exact, and no gcd is needed
+// until the result is formed. The elimination runs in `Checked<T>`; if an
+// intermediate overflows it is redone once in the double-width type, if
+// there is one, and overflow there throws xxint::overflow_too_large or
+// xxint::overflow_too_small whatever the policy of `Repr`.
+
+namespace detail {
+
+// Divides by a fixed non-zero divisor that is known to divide every
+// dividend: the divisor's trailing zeros are shifted out, and its odd part
+// is divided by multiplying with its inverse modulo 2^w.
+template <class T>
+class exact_divisor
+{
+public:
+    explicit exact_divisor(T divisor)
+    {
+        U odd    = xxint::detail::magnitude(divisor);
+        shift_   = xxint::detail::countr_zero(odd);
+        odd      = U(odd >> shift_);
+
+        // Newton's iteration; odd * odd == 1 mod 8, so `inverse_` starts
+        // correct to 3 bits and each step doubles that.
+        inverse_ = odd;
+        for (int bits = 3; bits < xxint::detail::int_traits<U>::width;
+                bits *= 2)
+            inverse_ = xxint::detail::mul_low<U>(
+                    inverse_, U(2 - xxint::detail::mul_low<U>(odd, inverse_)));
+
+        if (divisor < 0) inverse_ = U(U(0) - inverse_);
+    }
+
+    // `n / divisor`, which must be exact.
+    T divide(T n) const
+    {
+        return T(xxint::detail::mul_low<U>(U(n >> shift_), inverse_));
+    }
+
+private:
+    using U = xxint::detail::make_unsigned_t<T>;
+
+    U inverse_;
+    int shift_;
+};
+
+struct echelon_t
+{
+    std::size_t rank;
+    bool        negated;        // by an odd number of row swaps
+};
+
+// Reduces the `rows` by `cols` matrix `a`, stored by rows, to row echelon
+// form by Bareiss elimination, taking pivots from the first `pivot_cols`
+// columns, and leaving the pivots' rows first.
+template <class T>
+echelon_t bareiss(std::vector<T>& a, std::size_t rows, std::size_t cols,
+                  std::size_t pivot_cols)
+{
+    using C = xxint::Checked<T>;
+
+    echelon_t result{0, false};
+    T previous = 1;
+
+    for (std::size_t col = 0; col < pivot_cols && result.rank < rows; ++col) {
+        std::size_t top = result.rank;
+
+        std::size_t found = top;
+        while (found < rows && a[found * cols + col] == 0) ++found;
+        if (found == rows) continue;
+
+        if (found != top) {
+            std::swap_ranges(&a[found * cols], &a[found * cols] + cols,
+                             &a[top * cols]);
+            result.negated = !result.negated;
+        }
+
+        const T* pivot_row = &a[top * cols];
+        C pivot = pivot_row[col];
+        exact_divisor<T> divisor(previous);
+
+        for (std::size_t i = top + 1; i < rows; ++i) {
+            T* row = &a[i * cols];
+            C factor = row[col];
+            for (std::size_t j = col + 1; j < cols; ++j) {
+                C numerator = pivot * C(row[j]) - factor * C(pivot_row[j]);
+                row[j] = divisor.divide(numerator.get());
+            }
+            row[col] = 0;
+        }
+
+        previous = pivot.get();
+        ++result.rank;
+    }
+
+    return result;
+}
+
+// Runs `eliminate` on a copy of `entries` and passes its result to
+// `finish`, redoing the elimination in the double-width type if it
+// overflows. Only `eliminate` is retried, so overflow in `finish` is the
+// caller's to handle.
+template <class T, class Eliminate, class Finish>
+auto with_fallback(const std::vector<T>& entries,
+                   Eliminate eliminate, Finish finish,
+                   std::false_type /* has wider type */)
+{
+    std::vector<T> copy(entries);
+    return finish(eliminate(copy));
+}
+
+template <class T, class Eliminate, class Finish>
+auto with_fallback(const std::vector<T>& entries,
+                   Eliminate eliminate, Finish finish,
+                   std::true_type /* has wider type */)
+{
+    decltype(eliminate(std::declval<std::vector<T>&>())) result;
+
+    try {
+        std::vector<T> copy(entries);
+        result = eliminate(copy);
+    } catch (std::overflow_error&) {
+        using W = xxint::detail::wider_t<T>;
+        std::vector<W> wide(entries.begin(), entries.end());
+        return finish(eliminate(wide));
+    }
+
+    return finish(result);
+}
+
+// Runs `eliminate` and then `finish` on the entries of `a` as plain
+// integers, by rows, with the entry of `extra` appended to each row unless
+// it is empty.
+template <class Repr, class Eliminate, class Finish>
+auto eliminate_entries(const Matrix<Repr>& a, const std::vector<Repr>& extra,
+                       Eliminate eliminate, Finish finish)
+{
+    using T = typename repr_traits<Repr>::int_type;
+
+    std::vector<T> entries;
+    entries.reserve(a.rows() * (a.cols() + (extra.empty() ? 0 : 1)));
+    for (std::size_t i = 0; i < a.rows(); ++i) {
+        for (std::size_t j = 0; j < a.cols(); ++j)
+            entries.push_back(a(i, j).get());
+        if (!extra.empty()) entries.push_back(extra[i].get());
+    }
+
+    return with_fallback(
+            entries, eliminate, finish,
+            std::integral_constant<bool, repr_traits<Repr>::has_wide>());
+}
+
+// The rational `n/d`, where `d != 0`, in lowest terms, with the parts
+// narrowed to `Repr` according to its policy.
+template <class Repr, class W>
+Rational<Repr> narrow_fraction(W n, W d)
+{
+    using T = typename repr_traits<Repr>::int_type;
+    using U = xxint::detail::make_unsigned_t<W>;
+
+    // Narrowing goes through magnitudes, so it cannot overflow in `W`.
+    U divisor = xxint::gcd(n, d);
+    U num = U(xxint::detail::magnitude(n) / divisor);
+    U den = U(xxint::detail::magnitude(d) / divisor);
+
+    auto narrow = [](bool negative, U magnitude) {
+        return xxint::detail::from_magnitude<
+                T, repr_traits<Repr>::template policy>(
+                        negative, magnitude, false, "narrow_fraction");
+    };
+
+    return Rational<Repr>(narrow((n < 0) != (d < 0), num), narrow(false, den));
+}
+
+}
+
+/*
+ * Implementation
+ */
+
+template <class Repr>
+Matrix<Repr>::Matrix(
+        std::initializer_list<std::initializer_list<int_type>> rows)
+        : rows_(rows.size())
+        , cols_(rows.size() == 0 ? 0 : rows.begin()->size())
+{
+    entries_.reserve(rows_ * cols_);
+
+    for (auto const& row : rows) {
+        if (row.size() != cols_)
+            throw std::invalid_argument("Matrix: rows differ in length");
+        for (int_type each : row)
+            entries_.push_back(repr_t(each));
+    }
+}
+
+template <class Repr>
+Rational<Repr> determinant(const Matrix<Repr>& a)
+{
+    std::size_t n = a.rows();
+    if (a.cols() != n)
+        throw std::invalid_argument("determinant: matrix is not square");
+
+    auto eliminate = [n](auto& m) {
+        using T = typename std::decay_t<decltype(m)>::value_type;
+
+        if (n == 0) return T(1);
+
+        detail::echelon_t echelon = detail::bareiss(m, n, n, n);
+        if (echelon.rank < n) return T(0);
+
+        // The last pivot is the determinant of the row-swapped matrix.
+        xxint::Checked<T> result = m[n * n - 1];
+        return (echelon.negated ? -result : result).get();
+    };
+
+    auto finish = [](auto det) {
+        return detail::narrow_fraction<Repr>(det, decltype(det)(1));
+    };
+
+    return detail::eliminate_entries(a, {}, eliminate, finish);
+}
+
+template <class Repr>
+std::vector<Rational<Repr>> solve(const Matrix<Repr>& a,
+                                  const std::vector<Repr>& b)
+{
+    std::size_t n = a.rows();
+    if (a.cols() != n || b.size() != n)
+        throw std::invalid_argument("solve: sizes do not match");
+
+    // Eliminates `a` augmented with the column `b`, and then returns `y`
+    // followed by the last pivot `D`, where `x = y / D`. By Cramer's rule
+    // `y` is integral, and each back substitution divides exactly.
+    auto eliminate = [n](auto& m) {
+        using T = typename std::decay_t<decltype(m)>::value_type;
+        using C = xxint::Checked<T>;
+
+        const std::size_t cols = n + 1;
+
+        if (detail::bareiss(m, n, cols, n).rank < n)
+            throw std::domain_error("solve: matrix is singular");
+
+        if (n == 0) return std::vector<T>{1};
+
+        // The last pivot is `D` itself, so the last row gives its entry of
+        // `y` at once, which also keeps `D` times it out of the sums.
+        std::vector<T> y(n + 1);
+        C last = m[(n - 1) * cols + n - 1];
+        y[n] = last.get();
+        y[n - 1] = m[(n - 1) * cols + n];
+
+        for (std::size_t i = n - 1; i-- > 0; ) {
+            const T* row = &m[i * cols];
+            C sum = last * C(row[n]);
+            for (std::size_t j = i + 1; j < n; ++j)
+                sum = sum - C(row[j]) * C(y[j]);
+            y[i] = detail::exact_divisor<T>(row[i]).divide(sum.get());
+        }
+
+        return y;
+    };
+
+    auto finish = [n](const auto& y) {
+        std::vector<Rational<Repr>> x;
+        x.reserve(n);
+        for (std::size_t i = 0; i < n; ++i)
+            x.push_back(detail::narrow_fraction<Repr>(y[i], y[n]));
+        return x;
+    };
+
+    return detail::eliminate_entries(a, b, eliminate, finish);
+}
+
+template <class Repr>
+std::size_t rank(const Matrix<Repr>& a)
+{
+    std::size_t rows = a.rows(), cols = a.cols();
+
+    return detail::eliminate_entries(
+            a, {},
+            [=](auto& m) { return detail::bareiss(m, rows, cols, cols).rank; },
+            [](std::size_t r) { return r; });
+}
+
+}
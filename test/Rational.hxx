@@ -1,24 +1,204 @@
 #pragma once
 
 #include <xxint.hxx>
+#include <decimal.hxx>
+#include <gcd.hxx>
+#include <algorithm>
+#include <cmath>
+#include <functional>
 #include <iostream>
 #include <stdexcept>
+#include <type_traits>
 
 namespace rational {
 
-// Represents a rational number, that is, a fraction.
+namespace detail {
+
+// The integer type of a `Checked` representation.
+template <class Repr>
+struct repr_traits;
+
+template <class T, template <class> class P>
+struct repr_traits<xxint::Checked<T, P>>
+{
+    using int_type    = T;
+    using policy_type = P<T>;
+
+    // The policy for other integer types.
+    template <class U>
+    using policy = P<U>;
+
+    // Whether some integer type can hold the exact product of two
+    // `int_type`s.
+    static constexpr bool has_wide =
+            !std::is_void<xxint::detail::wider_t<T>>::value;
+};
+
+// Whether `x` fits in a double's 53-bit significand.
+template <class U>
+bool fits_significand(U, std::false_type /* wider than 53 bits */)
+{
+    return true;
+}
+
+template <class U>
+bool fits_significand(U x, std::true_type /* wider than 53 bits */)
+{
+    return x >> 53 == 0;
+}
+
+// The exact quotient `a / b` of magnitudes too wide for a double's
+// significand, rounded to the nearest double.
+template <class U>
+double quotient_to_double(U a, U b, std::false_type /* wider than 53 bits */)
+{
+    return double(a) / double(b);
+}
+
+// The quotient is extended by long division, in chunks as wide as a
+// double-width type allows, until it has two bits beyond the significand;
+// the remainder then supplies the sticky bit.
+//
+// Kept out of line so that `to_double` stays small enough to inline.
+template <class U>
+[[gnu::noinline]]
+double quotient_to_double(U a, U b, std::true_type /* wider than 53 bits */)
+{
+    using xxint::detail::bit_width;
+    using D = std::conditional_t<std::is_void<xxint::detail::wider_t<U>>::value,
+                                 U, xxint::detail::wider_t<U>>;
+
+    U quotient = a / b, remainder = a % b;
+    int exponent = 0;
+
+    // `b` is a denominator, so it is below 2^(w-1), and each chunk has at
+    // least one bit.
+    for (int bits = bit_width(quotient); bits < 55;
+            bits = bit_width(quotient)) {
+        int room  = xxint::detail::int_traits<D>::width - bit_width(b);
+        int chunk = std::min(55 - bits, room);
+        D extended = D(D(remainder) << chunk);
+        quotient  = U(U(quotient << chunk) | U(extended / b));
+        remainder = U(extended % b);
+        exponent -= chunk;
+    }
+
+    int shift = bit_width(quotient) - 53;
+    U kept    = U(quotient >> shift);
+    U dropped = U(quotient & U((U(1) << shift) - 1));
+    U half    = U(U(1) << (shift - 1));
+
+    if (dropped > half || (dropped == half && (remainder != 0 || (kept & 1))))
+        ++kept;
+
+    return std::ldexp(double(kept), exponent + shift);
+}
+
+// The unsigned type for the continued fraction of a double: wide enough
+// for the numerator and denominator of every double down to 2^-(w+53),
+// where `w` is the width of `U`, when a builtin type is.
+#ifdef XXINT_HAS_INT128
+using widest_word = xxint::detail::uint128_t;
+#else
+using widest_word = unsigned long long;
+#endif
+
+template <class U>
+using fraction_word_t = std::conditional_t<
+        (xxint::detail::int_traits<U>::width >
+         xxint::detail::int_traits<widest_word>::width),
+        U, widest_word>;
+
+// Finds the fraction `p/q` nearest to `n/d`, where `d > 0`, with `p` and
+// `q` at most `max_num` and `max_den`, which is below `2^(w-1)`.
+//
+// This runs through the convergents p1/q1, preceded by p0/q0, of the
+// continued fraction of n/d. When the next one would exceed a limit, the
+// only other candidate is the semiconvergent (p0 + k p1) / (q0 + k q1) for
+// the largest `k` within the limits, and with `t` the remaining complete
+// quotient, it is nearer exactly when t < 2k + q0/q1.
+template <class W>
+void best_approximation(W n, W d, W max_num, W max_den, W& p, W& q)
+{
+    const W unbounded = W(~W(0));
+    W p0 = 0, q0 = 1, p1 = 1, q1 = 0;
+
+    // Whether `a * b <= limit`, with a multiply rather than a division.
+    auto within = [](W a, W b, W limit) {
+        auto product = xxint::mul_wide(a, b);
+        return product.high == 0 && product.low <= limit;
+    };
+
+    for (;;) {
+        W a = n / d;
+
+        if (!within(a, q1, W(max_den - q0)) ||
+                !within(a, p1, W(max_num - p0))) {
+            W k = std::min(q1 == 0 ? unbounded : W((max_den - q0) / q1),
+                           p1 == 0 ? unbounded : W((max_num - p0) / p1));
+            auto left  = xxint::mul_wide(n, q1);
+            auto right = xxint::mul_wide(d, W(2 * k * q1 + q0));
+            if (k > 0 && (left.high < right.high ||
+                          (left.high == right.high && left.low < right.low))) {
+                p1 = W(p0 + k * p1);
+                q1 = W(q0 + k * q1);
+            }
+            break;
+        }
+
+        W p2 = W(p0 + a * p1), q2 = W(q0 + a * q1);
+        p0 = p1; q0 = q1;
+        p1 = p2; q1 = q2;
+
+        W r = W(n - a * d);
+        n = d;
+        d = r;
+        if (d == 0) break;
+    }
+
+    p = p1;
+    q = q1;
+}
+
+// Pushes the run of digits at the start of `[first, last)` into `acc`,
+// and returns the end of the run.
+template <class U>
+const char* parse_digits(const char* first, const char* last,
+                         xxint::detail::digit_accumulator<U>& acc)
+{
+    for (; first != last && unsigned(*first - '0') < 10; ++first)
+        acc.push(unsigned(*first - '0'));
+
+    return first;
+}
+
+}
+
+// Represents a rational number, that is, a fraction, whose numerator and
+// denominator are stored as `Repr`, a `Checked` integer type.
+template <class Repr>
+class RationalAccumulator;
+
+class HybridRational;
+
+template <class Repr = xxint::Checked<long>>
 class Rational
 {
 public:
+    using repr_t   = Repr;
+    using int_type = typename detail::repr_traits<Repr>::int_type;
+
     // Constructs the rational representing 0
-    Rational();
+    Rational() : num_(0), den_(1)
+    { }
 
     // Constructs the rational representing `n`
-    Rational(long n);
+    Rational(int_type n) : num_(n), den_(1)
+    { }
 
     // Constructs the rational representing `n/d`; throws
     // std::overflow_error if `d` is 0.
-    Rational(long n, long d);
+    Rational(int_type n, int_type d);
 
     // Note: Only three arithmetic operations are members, and the rest
     // are free functions declared below. The reason is that these three
@@ -38,40 +218,759 @@ public:
     Rational operator+(Rational) const;
 
     // Gets the numerator
-    long numerator() const { return num_.get(); }
+    int_type numerator() const { return num_.get(); }
 
     // Gets the denominator
-    long denominator() const { return den_.get(); }
+    int_type denominator() const { return den_.get(); }
 
 private:
-    using repr_t = xxint::Checked<long>;
     repr_t num_, den_;
     // invariants:
     //   den > 0
     //   gcd(num, den) == 1
+
+    template <class>
+    friend class RationalAccumulator;
+    friend class HybridRational;
+
+    using has_wide_t =
+        std::integral_constant<bool, detail::repr_traits<Repr>::has_wide>;
+
+    // Reduces `n/d`, where `d > 0`, and narrows it back to `repr_t`.
+    template <class W>
+    static Rational reduce_(W n, W d);
+
+    // Multiplication by an integer, which needs one word-sized gcd.
+    Rational scale_(repr_t) const;
+
+    // Addition of an integer, which needs no gcd.
+    Rational shift_(repr_t, std::true_type) const;
+    Rational shift_(repr_t, std::false_type) const;
+
+    // Multiplication and addition in a double-width type, reducing once.
+    Rational multiply_(Rational, std::true_type) const;
+    Rational add_(Rational, std::true_type) const;
+
+    // Multiplication and addition for the widest types, cancelling common
+    // factors first so that the intermediates fit.
+    Rational multiply_(Rational, std::false_type) const;
+    Rational add_(Rational, std::false_type) const;
+};
+
+template <class Repr>
+bool operator==(Rational<Repr>, Rational<Repr>);
+template <class Repr>
+bool operator!=(Rational<Repr>, Rational<Repr>);
+template <class Repr>
+bool operator<(Rational<Repr>, Rational<Repr>);
+template <class Repr>
+bool operator<=(Rational<Repr>, Rational<Repr>);
+template <class Repr>
+bool operator>(Rational<Repr>, Rational<Repr>);
+template <class Repr>
+bool operator>=(Rational<Repr>, Rational<Repr>);
+
+template <class Repr>
+std::ostream& operator<<(std::ostream&, Rational<Repr>);
+
+// Formats `r` into `[first, last)` as `n` or `n/d`, without going through
+// iostreams. If the buffer is too small, returns `{last,
+// std::errc::value_too_large}`.
+template <class Repr>
+xxint::to_chars_result to_chars(char* first, char* last, Rational<Repr> r);
+
+// Parses a rational from `[first, last)`: an optional `-`, and then digits
+// `n`, digits `n/d`, or a finite decimal such as `1.25` or `.5`.
+//
+// The numerator and denominator are parsed separately and then reduced
+// once. If either does not fit in `T` it is handled by policy `P`, and a
+// denominator of 0 throws std::overflow_error. On a syntax error, returns
+// `{first, std::errc::invalid_argument}` and leaves `value` unchanged.
+// `P` must not be a wrapping policy.
+template <class T, template <class> class P>
+xxint::from_chars_result from_chars(const char* first, const char* last,
+                                    Rational<xxint::Checked<T, P>>& value);
+
+// Converts to the nearest double, ties to even.
+template <class Repr>
+double to_double(Rational<Repr>);
+
+// Finds the rational nearest to `x` whose denominator is at most
+// `max_denominator`, from the continued fraction of the exact value of
+// `x`. The result is exact for any double with such a denominator.
+//
+// Throws std::invalid_argument if `x` is NaN or `max_denominator < 1`. If
+// `|x|` is not below 2^(w-1), where `w` is the width of the integer type,
+// it is handled by the policy of `Repr`, which must not wrap. For integer
+// types wider than the widest builtin, a tiny `|x|` may lose bits before it
+// is approximated.
+template <class Repr = xxint::Checked<long>>
+Rational<Repr> from_double(
+        double x,
+        typename Rational<Repr>::int_type max_denominator =
+            xxint::detail::int_traits<
+                typename Rational<Repr>::int_type>::max());
+
+template <class Repr>
+Rational<Repr> operator-(Rational<Repr>, Rational<Repr>);
+template <class Repr>
+Rational<Repr> operator/(Rational<Repr>, Rational<Repr>);
+
+template <class Repr>
+Rational<Repr>& operator+=(Rational<Repr>&, Rational<Repr>);
+template <class Repr>
+Rational<Repr>& operator-=(Rational<Repr>&, Rational<Repr>);
+template <class Repr>
+Rational<Repr>& operator*=(Rational<Repr>&, Rational<Repr>);
+template <class Repr>
+Rational<Repr>& operator/=(Rational<Repr>&, Rational<Repr>);
+
+template <class Repr>
+Rational<Repr>& operator++(Rational<Repr>&);
+template <class Repr>
+Rational<Repr>& operator--(Rational<Repr>&);
+template <class Repr>
+Rational<Repr> operator++(Rational<Repr>&, int);
+template <class Repr>
+Rational<Repr> operator--(Rational<Repr>&, int);
+
+// Sums many rationals without reducing after every addition.
+//
+// The running sum is an unreduced fraction in a type twice as wide as
+// `int_type` (or `int_type` itself if there is none), and its denominator
+// is the lcm of the denominators added so far. Each addition then needs
+// only a gcd with the new denominator, which is cheap when denominators
+// are small, as in harmonic-style sums. The sum is reduced when an
+// addition would otherwise overflow, and once more by `total()`.
+template <class Repr = xxint::Checked<long>>
+class RationalAccumulator
+{
+public:
+    using rational_t = Rational<Repr>;
+    using int_type   = typename rational_t::int_type;
+
+    // Constructs an accumulator whose sum is 0
+    RationalAccumulator() : num_(0), den_(1)
+    { }
+
+    // Adds `r` to the sum; throws std::overflow_error if the sum does not
+    // fit in the wide type even when reduced.
+    RationalAccumulator& operator+=(rational_t r);
+
+    // Subtracts `r` from the sum, like `+=`.
+    RationalAccumulator& operator-=(rational_t r);
+
+    // Gets the reduced sum; overflow on narrowing it to `Repr` is handled
+    // according to the policy of `Repr`.
+    rational_t total() const;
+
+private:
+    using wide_type = std::conditional_t<
+            detail::repr_traits<Repr>::has_wide,
+            xxint::detail::wider_t<int_type>,
+            int_type>;
+    using wide_t = xxint::Checked<wide_type>;
+
+    wide_t num_, den_;
+    // invariants:
+    //   den > 0
+
+    // Adds `n/d`, where `d > 0`; leaves the sum unchanged if it throws.
+    void add_(wide_t n, int_type d);
+
+    // Divides the numerator and denominator by their gcd.
+    void normalize_();
 };
 
-bool operator==(Rational, Rational);
-bool operator!=(Rational, Rational);
-bool operator<(Rational, Rational);
-bool operator<=(Rational, Rational);
-bool operator>(Rational, Rational);
-bool operator>=(Rational, Rational);
+/*
+ * Implementation
+ */
+
+template <class Repr>
+Rational<Repr>::Rational(int_type n, int_type d)
+{
+    if (d == 0)
+        throw std::overflow_error{"Rational::Rational: divide by 0"};
+
+    // The gcd is 2^(w-1) only for Rational(MIN, MIN); it then converts
+    // to MIN, which still divides both exactly.
+    auto divisor = static_cast<int_type>(xxint::gcd(n, d));
+    n /= divisor;
+    d /= divisor;
+
+    if (d < 0) {
+        num_ = -repr_t(n);
+        den_ = -repr_t(d);
+    } else {
+        num_ = n;
+        den_ = d;
+    }
+}
+
+template <class Repr>
+Rational<Repr> Rational<Repr>::operator-() const
+{
+    Rational result;
+    result.num_ = -num_;
+    result.den_ = den_;
+    return result;
+}
+
+template <class Repr>
+Rational<Repr> Rational<Repr>::reciprocal() const
+{
+    if (num_ == 0) throw std::overflow_error("Rational: reciprocal of 0");
+
+    Rational result;
+    if (num_ < 0) {
+        result.num_ = -den_;
+        result.den_ = -num_;
+    } else {
+        result.num_ = den_;
+        result.den_ = num_;
+    }
+
+    return result;
+}
+
+template <class Repr>
+Rational<Repr> Rational<Repr>::operator*(Rational other) const
+{
+    if (den_ == 1 && other.den_ == 1) {
+        Rational result;
+        result.num_ = num_ * other.num_;
+        return result;
+    }
+
+    if (den_ == 1) return other.scale_(num_);
+    if (other.den_ == 1) return scale_(other.num_);
+
+    return multiply_(other, has_wide_t());
+}
+
+template <class Repr>
+Rational<Repr> Rational<Repr>::operator+(Rational other) const
+{
+    if (den_ == 1 && other.den_ == 1) {
+        Rational result;
+        result.num_ = num_ + other.num_;
+        return result;
+    }
+
+    if (den_ == 1) return other.shift_(num_, has_wide_t());
+    if (other.den_ == 1) return shift_(other.num_, has_wide_t());
+
+    return add_(other, has_wide_t());
+}
+
+template <class Repr>
+Rational<Repr> Rational<Repr>::scale_(repr_t n) const
+{
+    // `num_` is coprime to `den_`, so only `n` can share factors with it.
+    repr_t divisor = xxint::gcd(n, den_);
+
+    Rational result;
+    result.num_ = n / divisor * num_;
+    result.den_ = den_ / divisor;
+    return result;
+}
+
+template <class Repr>
+Rational<Repr>
+Rational<Repr>::shift_(repr_t n, std::true_type) const
+{
+    using W = xxint::detail::wider_t<int_type>;
+
+    // gcd(num + n * den, den) == gcd(num, den) == 1, so the result needs
+    // no reduction, and it overflows only if its numerator does not fit.
+    Rational result;
+    result.num_ = repr_t(W(n.get()) * den_.get() + num_.get());
+    result.den_ = den_;
+    return result;
+}
+
+template <class Repr>
+Rational<Repr>
+Rational<Repr>::shift_(repr_t n, std::false_type) const
+{
+    Rational result;
+    result.num_ = n * den_ + num_;
+    result.den_ = den_;
+    return result;
+}
+
+template <class Repr>
+template <class W>
+Rational<Repr> Rational<Repr>::reduce_(W n, W d)
+{
+    // `d > 0`, so the gcd is at most `d` and fits in `W`.
+    auto divisor = static_cast<W>(xxint::gcd(n, d));
+
+    Rational result;
+
+    // Small operands give intermediates that still fit in `int_type`,
+    // where division is much cheaper.
+    auto narrow_n = static_cast<int_type>(n);
+    auto narrow_d = static_cast<int_type>(d);
+    if (narrow_n == n && narrow_d == d) {
+        auto narrow_divisor = static_cast<int_type>(divisor);
+        result.num_ = narrow_n / narrow_divisor;
+        result.den_ = narrow_d / narrow_divisor;
+    } else {
+        result.num_ = repr_t(n / divisor);
+        result.den_ = repr_t(d / divisor);
+    }
+
+    return result;
+}
+
+template <class Repr>
+Rational<Repr>
+Rational<Repr>::multiply_(Rational other, std::true_type) const
+{
+    using W = xxint::detail::wider_t<int_type>;
+
+    // Each product is at most 2^(2w-2) in magnitude, so neither overflows.
+    W n = W(num_.get()) * other.num_.get();
+    W d = W(den_.get()) * other.den_.get();
+
+    return reduce_(n, d);
+}
+
+template <class Repr>
+Rational<Repr>
+Rational<Repr>::add_(Rational other, std::true_type) const
+{
+    using W = xxint::detail::wider_t<int_type>;
+
+    // Each product is below 2^(2w-2) in magnitude, so their sum fits.
+    W n = W(num_.get()) * other.den_.get() + W(other.num_.get()) * den_.get();
+    W d = W(den_.get()) * other.den_.get();
+
+    return reduce_(n, d);
+}
+
+template <class Repr>
+Rational<Repr>
+Rational<Repr>::multiply_(Rational other, std::false_type) const
+{
+    auto ab_divisor = xxint::gcd(num_, other.den_);
+    auto ba_divisor = xxint::gcd(other.num_, den_);
+
+    auto a_num = num_ / ab_divisor;
+    auto a_den = den_ / ba_divisor;
+    auto b_num = other.num_ / ba_divisor;
+    auto b_den = other.den_ / ab_divisor;
+
+    Rational result;
+    result.num_ = a_num * b_num;
+    result.den_ = a_den * b_den;
+
+    return result;
+}
+
+template <class Repr>
+Rational<Repr>
+Rational<Repr>::add_(Rational other, std::false_type) const
+{
+    repr_t divisor = xxint::gcd(den_, other.den_);
+    auto a_den = den_ / divisor;
+    auto b_den = other.den_ / divisor;
+
+    auto a_num = b_den * num_;
+    auto b_num = a_den * other.num_;
+
+    auto numerator   = a_num + b_num;
+    auto denominator = a_den * b_den * divisor;
+
+    return Rational(numerator.get(), denominator.get());
+}
+
+template <class Repr>
+bool operator==(Rational<Repr> a, Rational<Repr> b)
+{
+    return a.numerator() == b.numerator() &&
+            a.denominator() == b.denominator();
+}
+
+template <class Repr>
+bool operator!=(Rational<Repr> a, Rational<Repr> b)
+{
+    return !(a == b);
+}
+
+// Compares without overflow, by the exact double-width cross products
+// from `mul_wide`, which are single multiplies when there is a wider type.
+//
+// Sign, equal-denominator and magnitude tests can settle many comparisons
+// before multiplying, but when sorting they are unpredictable branches,
+// and they measured slower than the multiplies, even for __int128.
+template <class Repr>
+bool operator<(Rational<Repr> a, Rational<Repr> b)
+{
+    auto left  = xxint::mul_wide(a.numerator(), b.denominator());
+    auto right = xxint::mul_wide(b.numerator(), a.denominator());
+    return left.high < right.high ||
+            (left.high == right.high && left.low < right.low);
+}
+
+template <class Repr>
+bool operator<=(Rational<Repr> a, Rational<Repr> b)
+{
+    return !(b < a);
+}
+
+template <class Repr>
+bool operator>(Rational<Repr> a, Rational<Repr> b)
+{
+    return b < a;
+}
+
+template <class Repr>
+bool operator>=(Rational<Repr> a, Rational<Repr> b)
+{
+    return b <= a;
+}
+
+template <class Repr>
+std::ostream& operator<<(std::ostream& o, Rational<Repr> r)
+{
+    using int_type = typename Rational<Repr>::int_type;
+
+    char buffer[2 * xxint::detail::int_traits<int_type>::digits / 3 + 6];
+    auto result = to_chars(buffer, buffer + sizeof buffer, r);
+    return o.write(buffer, result.ptr - buffer);
+}
+
+template <class Repr>
+xxint::to_chars_result to_chars(char* first, char* last, Rational<Repr> r)
+{
+    using xxint::detail::magnitude;
+    using int_type = typename Rational<Repr>::int_type;
+
+    // Enough for two magnitudes, a sign and a slash.
+    char buffer[2 * xxint::detail::int_traits<int_type>::digits / 3 + 6];
+    char* end = buffer + sizeof buffer;
+    char* begin = end;
+
+    if (r.denominator() != 1) {
+        begin = xxint::detail::write_digits(magnitude(r.denominator()), begin);
+        *--begin = '/';
+    }
+
+    begin = xxint::detail::write_digits(magnitude(r.numerator()), begin);
+    if (r.numerator() < 0) *--begin = '-';
+
+    if (last - first < end - begin)
+        return {last, std::errc::value_too_large};
+
+    while (begin < end)
+        *first++ = *begin++;
+
+    return {first, std::errc()};
+}
+
+template <class T, template <class> class P>
+xxint::from_chars_result from_chars(const char* first, const char* last,
+                                    Rational<xxint::Checked<T, P>>& value)
+{
+    static_assert(!P<T>::is_wrapping,
+                  "rational::from_chars: a wrapped numerator or denominator"
+                  " is not the rational that was written");
+
+    using xxint::detail::from_magnitude;
+    using U = xxint::detail::make_unsigned_t<T>;
+
+    const char* who = "rational::from_chars";
+    auto is_digit = [](char c) { return unsigned(c - '0') < 10; };
+
+    const char* p = first;
+    bool negative = p != last && *p == '-';
+    if (negative) ++p;
+
+    xxint::detail::digit_accumulator<U> num;
+    const char* digits = p;
+    p = detail::parse_digits(p, last, num);
+    bool any_digits = p != digits;
+
+    if (any_digits && p != last && *p == '/' &&
+            p + 1 != last && is_digit(p[1])) {
+        xxint::detail::digit_accumulator<U> den;
+        p = detail::parse_digits(p + 1, last, den);
+
+        value = Rational<xxint::Checked<T, P>>(
+                from_magnitude<T, P>(negative, num.value, num.overflow, who),
+                from_magnitude<T, P>(false, den.value, den.overflow, who));
+        return {p, std::errc()};
+    }
+
+    // The fraction digits join the numerator over a power of ten. Trailing
+    // zeros are dropped, so that `0.50` needs only `10^1`.
+    int scale = 0;
+    if (p != last && *p == '.' && p + 1 != last && is_digit(p[1])) {
+        int zeros = 0;
+        for (++p; p != last && is_digit(*p); ++p) {
+            unsigned digit = unsigned(*p - '0');
+            if (digit == 0) {
+                ++zeros;
+                continue;
+            }
+            for (; zeros > 0; --zeros, ++scale)
+                num.push(0);
+            num.push(digit);
+            ++scale;
+        }
+        any_digits = true;
+    }
+
+    if (!any_digits)
+        return {first, std::errc::invalid_argument};
+
+    T den = scale <= xxint::detail::max_pow10_exponent<T>()
+            ? xxint::detail::pow10<T>(scale)
+            : P<T>::too_large(who);
+
+    value = Rational<xxint::Checked<T, P>>(
+            from_magnitude<T, P>(negative, num.value, num.overflow, who), den);
+    return {p, std::errc()};
+}
+
+template <class Repr>
+double to_double(Rational<Repr> r)
+{
+    using int_type = typename Rational<Repr>::int_type;
+    using U = xxint::detail::make_unsigned_t<int_type>;
+    using wide_t = std::integral_constant<
+            bool, (xxint::detail::int_traits<int_type>::digits > 53)>;
+
+    U a = xxint::detail::magnitude(r.numerator()), b = U(r.denominator());
+    double magnitude;
+
+    // Exact operands make one division correctly rounded. Signed
+    // conversions are single instructions on common hardware.
+    if (detail::fits_significand(U(a | b), wide_t()))
+        magnitude = double(static_cast<long long>(a)) /
+                    double(static_cast<long long>(b));
+    else
+        magnitude = detail::quotient_to_double(a, b, wide_t());
+
+    return r.numerator() < 0 ? -magnitude : magnitude;
+}
+
+template <class Repr>
+Rational<Repr> from_double(double x,
+                           typename Rational<Repr>::int_type max_denominator)
+{
+    using int_type = typename Rational<Repr>::int_type;
+    using traits   = xxint::detail::int_traits<int_type>;
+    using W = detail::fraction_word_t<xxint::detail::make_unsigned_t<int_type>>;
 
-std::ostream& operator<<(std::ostream&, Rational);
-double to_double(Rational);
+    static_assert(!detail::repr_traits<Repr>::policy_type::is_wrapping,
+                  "rational::from_double: a wrapped integer part is not"
+                  " near the double");
 
-Rational operator-(Rational, Rational);
-Rational operator/(Rational, Rational);
+    if (std::isnan(x))
+        throw std::invalid_argument("rational::from_double: NaN");
+    if (max_denominator < 1)
+        throw std::invalid_argument("rational::from_double: bad bound");
 
-Rational& operator+=(Rational&, Rational);
-Rational& operator-=(Rational&, Rational);
-Rational& operator*=(Rational&, Rational);
-Rational& operator/=(Rational&, Rational);
+    const char* who = "rational::from_double";
+    bool negative = x < 0;
+    x = std::fabs(x);
 
-Rational& operator++(Rational&);
-Rational& operator--(Rational&);
-Rational operator++(Rational&, int);
-Rational operator--(Rational&, int);
+    if (!(x < std::ldexp(1.0, traits::digits))) {
+        using policy_type = typename detail::repr_traits<Repr>::policy_type;
+        return Rational<Repr>(negative ? policy_type::too_small(who)
+                                       : policy_type::too_large(who));
+    }
+
+    // x == n / d exactly, unless it is too small for `d` to fit.
+    int exponent;
+    auto mantissa = W(std::ldexp(std::frexp(x, &exponent), 53));
+    exponent -= 53;
+
+    W n = mantissa, d = 1;
+    if (exponent >= 0) {
+        n = W(mantissa << exponent);
+    } else {
+        int places = -exponent;
+        const int room = xxint::detail::int_traits<W>::width - 1;
+        if (places > room) {
+            n = places - room < 53 ? W(n >> (places - room)) : W(0);
+            places = room;
+        }
+        if (n == 0) return Rational<Repr>();
+
+        int zeros = std::min(xxint::detail::countr_zero(n), places);
+        n = W(n >> zeros);
+        d = W(W(1) << (places - zeros));
+    }
+
+    // Most doubles fit in single words, where division is much cheaper.
+    using small_word = unsigned long long;
+    const W max_num = W(traits::max()), max_den = W(max_denominator);
+    W p, q;
+
+    if (sizeof(W) > sizeof(small_word) && traits::width <= 64 &&
+            n == small_word(n) && d == small_word(d)) {
+        small_word small_p, small_q;
+        detail::best_approximation(small_word(n), small_word(d),
+                                   small_word(max_num), small_word(max_den),
+                                   small_p, small_q);
+        p = small_p;
+        q = small_q;
+    } else {
+        detail::best_approximation(n, d, max_num, max_den, p, q);
+    }
+
+    auto num = static_cast<int_type>(p);
+    return Rational<Repr>(negative ? int_type(-num) : num,
+                          static_cast<int_type>(q));
+}
+
+template <class Repr>
+Rational<Repr> operator-(Rational<Repr> a, Rational<Repr> b)
+{
+    return a + -b;
+}
+
+template <class Repr>
+Rational<Repr> operator/(Rational<Repr> a, Rational<Repr> b)
+{
+    return a * b.reciprocal();
+}
+
+template <class Repr>
+Rational<Repr>& operator+=(Rational<Repr>& a, Rational<Repr> b)
+{
+    return a = a + b;
+}
+
+template <class Repr>
+Rational<Repr>& operator-=(Rational<Repr>& a, Rational<Repr> b)
+{
+    return a = a - b;
+}
+
+template <class Repr>
+Rational<Repr>& operator*=(Rational<Repr>& a, Rational<Repr> b)
+{
+    return a = a * b;
+}
+
+template <class Repr>
+Rational<Repr>& operator/=(Rational<Repr>& a, Rational<Repr> b)
+{
+    return a = a / b;
+}
+
+// Takes the integer fast path of operator+, so this needs no gcd.
+template <class Repr>
+Rational<Repr>& operator++(Rational<Repr>& r)
+{
+    return r = r + Rational<Repr>(1);
+}
+
+template <class Repr>
+Rational<Repr>& operator--(Rational<Repr>& r)
+{
+    return r = r - Rational<Repr>(1);
+}
+
+template <class Repr>
+Rational<Repr> operator++(Rational<Repr>& r, int)
+{
+    Rational<Repr> result = r;
+    ++r;
+    return result;
+}
+
+template <class Repr>
+Rational<Repr> operator--(Rational<Repr>& r, int)
+{
+    Rational<Repr> result = r;
+    --r;
+    return result;
+}
+
+template <class Repr>
+RationalAccumulator<Repr>&
+RationalAccumulator<Repr>::operator+=(rational_t r)
+{
+    try {
+        add_(wide_t(r.numerator()), r.denominator());
+    } catch (std::overflow_error&) {
+        normalize_();
+        add_(wide_t(r.numerator()), r.denominator());
+    }
+
+    return *this;
+}
+
+template <class Repr>
+RationalAccumulator<Repr>&
+RationalAccumulator<Repr>::operator-=(rational_t r)
+{
+    try {
+        add_(-wide_t(r.numerator()), r.denominator());
+    } catch (std::overflow_error&) {
+        normalize_();
+        add_(-wide_t(r.numerator()), r.denominator());
+    }
+
+    return *this;
+}
+
+template <class Repr>
+Rational<Repr> RationalAccumulator<Repr>::total() const
+{
+    return rational_t::reduce_(num_.get(), den_.get());
+}
+
+template <class Repr>
+void RationalAccumulator<Repr>::add_(wide_t n, int_type d)
+{
+    // gcd(den, d) == gcd(d, den % d), so one wide division leaves a gcd of
+    // two narrow values, and since the gcd divides both `d` and the
+    // remainder, den / gcd follows without dividing again.
+    wide_t quotient  = den_ / wide_t(d);
+    auto   remainder = static_cast<int_type>((den_ - quotient * d).get());
+    auto   divisor   = static_cast<int_type>(xxint::gcd(d, remainder));
+
+    int_type scale = d / divisor;
+    wide_t cofactor = quotient * scale + remainder / divisor;
+
+    // The new denominator is lcm(den, d) == den * scale.
+    wide_t numerator   = num_ * scale + n * cofactor;
+    wide_t denominator = den_ * scale;
+
+    num_ = numerator;
+    den_ = denominator;
+}
+
+template <class Repr>
+void RationalAccumulator<Repr>::normalize_()
+{
+    wide_t divisor = xxint::gcd(num_, den_);
+    num_ /= divisor;
+    den_ /= divisor;
+}
+
+}
+
+namespace std {
+
+// Hashes rationals by value. They are always in lowest terms, so equal
+// values have equal parts.
+template <class Repr>
+struct hash<rational::Rational<Repr>>
+{
+    size_t operator()(rational::Rational<Repr> r) const noexcept
+    {
+        using xxint::detail::hash_integer;
+        return static_cast<size_t>(xxint::hash_combine(
+                hash_integer(r.numerator()), hash_integer(r.denominator())));
+    }
+};
 
 }
@@ -0,0 +1,88 @@
+#include <alloc.hxx>
+#include <catch.hxx>
+#include <cstdint>
+#include <new>
+
+using xxint::alloc_size;
+using xxint::policy::saturating;
+
+namespace {
+
+struct Entry
+{
+    uint64_t key;
+    uint32_t value;
+};
+
+}
+
+TEST_CASE("alloc_size")
+{
+    CHECK(alloc_size<Entry>(10) == 10 * sizeof(Entry));
+    CHECK(alloc_size<Entry>(10, 8, 5u) == 10 * sizeof(Entry) + 13);
+    CHECK(alloc_size<char>(0) == 0);
+    CHECK(alloc_size<uint32_t>(SIZE_MAX / 4) == SIZE_MAX / 4 * 4);
+    CHECK(alloc_size<uint32_t>(SIZE_MAX / 4, 3) == SIZE_MAX);
+
+    static_assert(alloc_size<uint32_t>(4, 2).get() == 18, "constexpr");
+
+    // The product wraps to a small size.
+    CHECK_THROWS_AS(alloc_size<uint32_t>(SIZE_MAX / 4 + 1),
+                    xxint::overflow_too_large);
+    CHECK_THROWS_AS(alloc_size<uint64_t>(SIZE_MAX / 4),
+                    xxint::overflow_too_large);
+
+    // The sum wraps.
+    CHECK_THROWS_AS(alloc_size<uint32_t>(SIZE_MAX / 4, 4),
+                    xxint::overflow_too_large);
+    CHECK_THROWS_AS(alloc_size<char>(1, SIZE_MAX / 2, SIZE_MAX / 2, 1),
+                    xxint::overflow_too_large);
+
+    // A negative count or extra, as read from a corrupt header.
+    CHECK_THROWS_AS(alloc_size<Entry>(-1), xxint::overflow_too_small);
+    CHECK_THROWS_AS(alloc_size<Entry>(1, -16), xxint::overflow_too_small);
+
+    CHECK(alloc_size<uint64_t, saturating>(SIZE_MAX / 4) == SIZE_MAX);
+    CHECK(alloc_size<char, saturating>(SIZE_MAX, 1) == SIZE_MAX);
+    CHECK(alloc_size<char, saturating>(-1) == SIZE_MAX);
+    CHECK(alloc_size<int, saturating>(10, -100) == SIZE_MAX);
+    CHECK(alloc_size<int, saturating>(-10, 8) == SIZE_MAX);
+    CHECK(alloc_size<int, saturating>(xxint::Checked<uint32_t>(10)) == 40);
+}
+
+TEST_CASE("arena")
+{
+    xxint::arena a(64);
+    CHECK(a.capacity() == 64);
+
+    auto c = a.allocate<char>(3);
+    auto e = a.allocate<Entry>(2);
+    CHECK(reinterpret_cast<std::uintptr_t>(e) % alignof(Entry) == 0);
+    CHECK(reinterpret_cast<char*>(e) - c == alignof(Entry));
+    CHECK(a.used() == alignof(Entry) + 2 * sizeof(Entry));
+
+    e[1].value = 7;
+    CHECK(e[1].value == 7);
+
+    std::size_t used = a.used();
+    CHECK_THROWS_AS(a.allocate<Entry>(SIZE_MAX / 8), std::bad_alloc);
+    CHECK_THROWS_AS(a.allocate<Entry>(3), std::bad_alloc);
+    CHECK_THROWS_AS(a.allocate(SIZE_MAX, 1), std::bad_alloc);
+    CHECK_THROWS_AS(a.allocate<Entry>(-1), xxint::overflow_too_small);
+    CHECK(a.used() == used);
+
+    auto rest = a.allocate(a.remaining(), 1);
+    CHECK(rest == reinterpret_cast<char*>(e) + 2 * sizeof(Entry));
+    CHECK(a.remaining() == 0);
+    CHECK(a.allocate<char>(0) != nullptr);
+
+    a.reset();
+    CHECK(a.allocate<char>() == c);
+
+    // Over a caller's buffer.
+    alignas(16) unsigned char buffer[32];
+    xxint::arena b(buffer + 1, 31);
+    CHECK(b.allocate(4, 16) == buffer + 16);
+    CHECK(b.used() == 19);
+    CHECK(b.allocate(1, 1) == buffer + 20);
+}
@@ -0,0 +1,193 @@
+#include <xxint.hxx>
+#include <catch.hxx>
+#include <cstdint>
+
+using xxint::Checked;
+using xxint::Saturating;
+using xxint::Wrapping;
+using xxint::detail::int_traits;
+
+// Exhaustively checks the arithmetic of `Checked<T>`, `Saturating<T>` and
+// `Wrapping<T>`, and conversions into `T`, against exact `long long`
+// arithmetic. Only useful for narrow `T`.
+template <class T>
+struct Exhaustive
+{
+    using C = Checked<T>;
+    using S = Saturating<T>;
+    using W = Wrapping<T>;
+
+    static long long lo() { return static_cast<long long>(int_traits<T>::min()); }
+    static long long hi() { return static_cast<long long>(int_traits<T>::max()); }
+
+    static long long clamp(long long x)
+    {
+        return x < lo() ? lo() : x > hi() ? hi() : x;
+    }
+
+    static long long wrap(long long x)
+    {
+        unsigned long long modulus = 1ULL << int_traits<T>::width;
+        unsigned long long u = static_cast<unsigned long long>(x) & (modulus - 1);
+        if (int_traits<T>::is_signed && u > static_cast<unsigned long long>(hi()))
+            return static_cast<long long>(u) - static_cast<long long>(modulus);
+        return static_cast<long long>(u);
+    }
+
+    // Returns the number of mismatches between `thunk()` and `exact`.
+    template <class Thunk>
+    static int checked_matches(long long exact, Thunk thunk)
+    {
+        try {
+            long long actual = static_cast<long long>(thunk().get());
+            return exact < lo() || exact > hi() || actual != exact;
+        } catch (xxint::overflow_too_large&) {
+            return exact <= hi();
+        } catch (xxint::overflow_too_small&) {
+            return exact >= lo();
+        }
+    }
+
+    template <class Thunk>
+    static int value_matches(long long exact, Thunk thunk)
+    {
+        return static_cast<long long>(thunk().get()) != exact;
+    }
+
+    static int conversions()
+    {
+        int failures = 0;
+
+        for (long long x = lo() - 3; x <= hi() + 3; ++x) {
+            failures += checked_matches(x, [=] {
+                return C(xxint::convert_exn<T>(x));
+            });
+            failures += value_matches(clamp(x), [=] {
+                return C(xxint::convert_sat<T>(x));
+            });
+            failures += xxint::detail::is_too_small_for<T>(x) != (x < lo());
+            failures += xxint::detail::is_too_large_for<T>(x) != (x > hi());
+        }
+
+        return failures;
+    }
+
+    static int binops()
+    {
+        int failures = 0;
+
+        for (long long a = lo(); a <= hi(); ++a) {
+            for (long long b = lo(); b <= hi(); ++b) {
+                T ta = static_cast<T>(a), tb = static_cast<T>(b);
+
+                failures += checked_matches(a + b, [=] { return C(ta) + C(tb); });
+                failures += checked_matches(a - b, [=] { return C(ta) - C(tb); });
+                failures += checked_matches(a * b, [=] { return C(ta) * C(tb); });
+
+                failures += value_matches(clamp(a + b), [=] { return S(ta) + S(tb); });
+                failures += value_matches(clamp(a - b), [=] { return S(ta) - S(tb); });
+                failures += value_matches(clamp(a * b), [=] { return S(ta) * S(tb); });
+
+                failures += value_matches(wrap(a + b), [=] { return W(ta) + W(tb); });
+                failures += value_matches(wrap(a - b), [=] { return W(ta) - W(tb); });
+                failures += value_matches(wrap(a * b), [=] { return W(ta) * W(tb); });
+
+                if (b != 0) {
+                    failures += checked_matches(a / b, [=] { return C(ta) / C(tb); });
+                    failures += checked_matches(a % b, [=] { return C(ta) % C(tb); });
+                }
+
+                failures += (C(ta) < C(tb)) != (a < b);
+                failures += (C(ta) == C(tb)) != (a == b);
+            }
+        }
+
+        return failures;
+    }
+
+    static int shifts()
+    {
+        int failures = 0;
+
+        for (long long a = lo(); a <= hi(); ++a) {
+            for (int s = 0; s <= int_traits<T>::width + 1; ++s) {
+                failures += checked_matches(a * (1LL << s), [=] {
+                    return C(static_cast<T>(a)) << s;
+                });
+            }
+        }
+
+        return failures;
+    }
+
+    static void check()
+    {
+        CHECK(0 == conversions());
+        CHECK(0 == binops());
+        CHECK(0 == shifts());
+    }
+};
+
+TEST_CASE("int_traits")
+{
+    CHECK(int_traits<int8_t>::width == 8);
+    CHECK(int_traits<int8_t>::digits == 7);
+    CHECK(int_traits<uint16_t>::digits == 16);
+    CHECK(int_traits<bool>::digits == 1);
+
+    CHECK(xxint::detail::is_as_wide_as<long long, long>());
+    CHECK(xxint::detail::is_as_wide_as<long, long long>());
+}
+
+TEST_CASE("Exhaustive_8_bit")
+{
+    Exhaustive<int8_t>::check();
+    Exhaustive<uint8_t>::check();
+}
+
+#ifdef XXINT_HAS_BIT_INT
+
+static_assert(int_traits<_BitInt(24)>::width == 24, "_BitInt width");
+static_assert(int_traits<_BitInt(24)>::digits == 23, "_BitInt digits");
+static_assert(int_traits<unsigned _BitInt(40)>::digits == 40, "_BitInt digits");
+static_assert(!xxint::detail::is_as_wide_as<_BitInt(24), int32_t>(),
+              "_BitInt(24) is narrower than int32_t despite equal sizeof");
+static_assert(xxint::detail::is_as_wide_as<int32_t, _BitInt(24)>(),
+              "int32_t holds every _BitInt(24)");
+static_assert(xxint::detail::is_as_wide_as<_BitInt(48), unsigned _BitInt(40)>(),
+              "_BitInt(48) holds every unsigned _BitInt(40)");
+
+TEST_CASE("BitInt_bounds")
+{
+    using C24 = Checked<_BitInt(24)>;
+    using U40 = Checked<unsigned _BitInt(40)>;
+
+    CHECK(C24((1 << 23) - 1) + C24(0) == (1 << 23) - 1);
+    CHECK_THROWS_AS(C24((1 << 23) - 1) + C24(1), xxint::overflow_too_large);
+    CHECK_THROWS_AS(C24(-(1 << 23)) - C24(1), xxint::overflow_too_small);
+    CHECK_THROWS_AS(C24(1 << 23), xxint::overflow_too_large);
+    CHECK_THROWS_AS(C24(1) << 23, xxint::overflow_too_large);
+
+    CHECK(U40((1ULL << 40) - 1) == (1ULL << 40) - 1);
+    CHECK_THROWS_AS(U40(1ULL << 40), xxint::overflow_too_large);
+    CHECK_THROWS_AS(U40(1) << 40, xxint::overflow_too_large);
+
+    CHECK(Saturating<_BitInt(24)>(1 << 30) == (1 << 23) - 1);
+    CHECK(Wrapping<_BitInt(24)>((1 << 23) - 1) + 1 == -(1 << 23));
+}
+
+TEST_CASE("Exhaustive_BitInt")
+{
+    Exhaustive<_BitInt(2)>::check();
+    Exhaustive<_BitInt(3)>::check();
+    Exhaustive<_BitInt(5)>::check();
+    Exhaustive<_BitInt(7)>::check();
+    Exhaustive<_BitInt(10)>::check();
+
+    Exhaustive<unsigned _BitInt(2)>::check();
+    Exhaustive<unsigned _BitInt(3)>::check();
+    Exhaustive<unsigned _BitInt(6)>::check();
+    Exhaustive<unsigned _BitInt(9)>::check();
+}
+
+#endif // XXINT_HAS_BIT_INT
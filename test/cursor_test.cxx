@@ -0,0 +1,99 @@
+#include <cursor.hxx>
+#include <catch.hxx>
+#include <cstdint>
+#include <vector>
+
+using xxint::byte_cursor;
+using xxint::byte_order;
+
+TEST_CASE("byte_cursor read")
+{
+    const uint8_t bytes[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+                             0xFF, 0xFE, 0x80, 0x00, 0x00, 0x00, 0x00, 0x01};
+    byte_cursor in(bytes, sizeof bytes);
+
+    CHECK(in.read<uint8_t>() == 0x01);
+    CHECK(in.read<uint16_t>() == 0x0302);
+    CHECK((in.read<uint16_t, byte_order::big>() == 0x0405));
+    CHECK((in.read<uint16_t, byte_order::big>() == 0x0607));
+    CHECK(in.offset() == 7);
+    CHECK(in.read<int8_t>() == 8);
+    CHECK(in.read<int16_t>() == -257);
+    CHECK((in.read<int8_t, byte_order::big>() == -128));
+    CHECK(in.remaining() == 5);
+    CHECK((in.read<int32_t, byte_order::big>() == 0));
+    CHECK_THROWS_AS(in.read<uint16_t>(), xxint::out_of_bounds);
+    CHECK(in.remaining() == 1);
+    CHECK(in.read<uint8_t>() == 1);
+
+    in.seek(0);
+    CHECK(in.read<uint64_t>() == 0x0807060504030201);
+    CHECK((in.read<uint64_t, byte_order::big>() == 0xFFFE800000000001));
+    CHECK(in.remaining() == 0);
+    CHECK_THROWS_AS(in.read<uint8_t>(), xxint::out_of_bounds);
+    CHECK_THROWS_AS(in.seek(17), xxint::out_of_bounds);
+
+    in.seek(16);
+    in.seek(2);
+    uint16_t pairs[3];
+    in.read<uint16_t, byte_order::big>(pairs, 3);
+    CHECK(pairs[0] == 0x0304);
+    CHECK(pairs[2] == 0x0708);
+    CHECK_THROWS_AS(in.read(pairs, 5), xxint::out_of_bounds);
+    CHECK(in.offset() == 8);
+}
+
+TEST_CASE("byte_cursor record")
+{
+    // A count, then that many records of a big-endian id and value.
+    std::vector<uint8_t> message{0, 0, 0, 2,
+                                 0, 0, 0, 7, 0xFF, 0xFF,
+                                 0, 0, 0, 9, 0x00, 0x10};
+    byte_cursor in(message.data(), message.data() + message.size());
+
+    auto count = in.read<uint32_t, byte_order::big>();
+    auto items = in.record(byte_cursor::size_type(count) * 6);
+    CHECK(items.remaining() == 12);
+    CHECK(in.remaining() == 0);
+
+    CHECK((items.read<uint32_t, byte_order::big>() == 7));
+    CHECK((items.read<int16_t, byte_order::big>() == -1));
+    items.skip(4);
+    CHECK((items.read<int16_t, byte_order::big>() == 16));
+    CHECK(items.remaining() == 0);
+
+    // A count too large for the message.
+    message[3] = 3;
+    in = byte_cursor(message.data(), message.size());
+    count = in.read<uint32_t, byte_order::big>();
+    CHECK_THROWS_AS(in.record(byte_cursor::size_type(count) * 6),
+                    xxint::out_of_bounds);
+    CHECK(in.offset() == 4);
+
+    auto nested = in.take(6);
+    CHECK(nested.size() == 6);
+    CHECK((nested.read<uint32_t, byte_order::big>() == 7));
+    CHECK_THROWS_AS(nested.skip(3), xxint::out_of_bounds);
+    CHECK(in.offset() == 10);
+}
+
+TEST_CASE("byte_cursor length overflow")
+{
+    const uint8_t bytes[16] = {};
+    byte_cursor in(bytes, sizeof bytes);
+
+    // A count that would wrap to a small length.
+    uint64_t count = (uint64_t(1) << 62) + 1;
+    CHECK_THROWS_AS(in.record(byte_cursor::size_type(count) * 4),
+                    xxint::overflow_too_large);
+    CHECK_THROWS_AS(in.skip(byte_cursor::size_type(8) + SIZE_MAX),
+                    xxint::overflow_too_large);
+
+    // A negative length field.
+    int32_t length = -4;
+    CHECK_THROWS_AS(in.skip(length), xxint::overflow_too_small);
+    CHECK(in.offset() == 0);
+
+    CHECK(in.has(16));
+    CHECK_FALSE(in.has(17));
+}
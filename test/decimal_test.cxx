@@ -0,0 +1,157 @@
+#include <decimal.hxx>
+#include <catch.hxx>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+using xxint::Decimal;
+using xxint::rounding;
+namespace policy = xxint::policy;
+
+using Money = Decimal<int64_t, 2>;
+using D2 = Decimal<int32_t, 2>;
+
+static std::string format(D2 d)
+{
+    char buffer[16];
+    auto result = xxint::to_chars(buffer, buffer + sizeof buffer, d);
+    REQUIRE(result.ec == std::errc());
+    return std::string(buffer, result.ptr);
+}
+
+template <rounding R = rounding::nearest_even, class D>
+static D parse(const char* s, D init = D())
+{
+    auto result = xxint::from_chars<R>(s, s + std::strlen(s), init);
+    CHECK(result.ec == std::errc());
+    CHECK(*result.ptr == '\0');
+    return init;
+}
+
+TEST_CASE("pow10")
+{
+    using xxint::detail::pow10;
+    using xxint::detail::max_pow10_exponent;
+
+    CHECK(max_pow10_exponent<int8_t>() == 2);
+    CHECK(max_pow10_exponent<uint8_t>() == 2);
+    CHECK(max_pow10_exponent<int32_t>() == 9);
+    CHECK(max_pow10_exponent<uint64_t>() == 19);
+    CHECK(pow10<int32_t>(0) == 1);
+    CHECK(pow10<int32_t>(9) == 1000000000);
+    CHECK(pow10<int64_t>(18) == 1000000000000000000LL);
+}
+
+TEST_CASE("Decimal_arithmetic")
+{
+    auto price = Money::from_raw(1999);
+
+    CHECK(Money(3).raw() == 300);
+    CHECK((price + price).raw() == 3998);
+    CHECK((price * Money(3)).raw() == 5997);
+    CHECK((Money(10) / Money(4)).raw() == 250);
+    CHECK_THROWS_AS(Money(1) / Money(0), xxint::overflow_div_zero);
+    CHECK_THROWS_AS(D2(30000000), xxint::overflow_too_large);
+    CHECK_THROWS_AS(D2(20000000) + D2(20000000), xxint::overflow_too_large);
+    CHECK_THROWS_AS(D2(50000) * D2(50000), xxint::overflow_too_large);
+
+    using SD2 = Decimal<int32_t, 2, policy::saturating>;
+    CHECK(SD2(50000) * SD2(-50000) == SD2::from_raw(INT32_MIN));
+}
+
+TEST_CASE("Decimal_rounding")
+{
+    // 0.125 * 1 at scale 2 is a tie.
+    auto eighth = D2::from_raw(125).rescale<2>();
+    CHECK(eighth.raw() == 125);
+
+    using D3 = Decimal<int32_t, 3>;
+    auto tie   = D3::from_raw(125);    // 0.125
+    auto ntie  = D3::from_raw(-125);
+    auto above = D3::from_raw(126);
+
+    CHECK((tie.rescale<2, rounding::nearest_even>().raw() == 12));
+    CHECK((tie.rescale<2, rounding::nearest>().raw() == 13));
+    CHECK((ntie.rescale<2, rounding::nearest_even>().raw() == -12));
+    CHECK((ntie.rescale<2, rounding::nearest>().raw() == -13));
+    CHECK((ntie.rescale<2, rounding::floor>().raw() == -13));
+    CHECK((ntie.rescale<2, rounding::toward_zero>().raw() == -12));
+    CHECK((above.rescale<2, rounding::nearest_even>().raw() == 13));
+    CHECK((tie.rescale<5>().raw() == 12500));
+    CHECK_THROWS_AS((D2(20000000).rescale<3>()), xxint::overflow_too_large);
+
+    // 1/3 and 2/3 of a cent, then ties at half a cent.
+    CHECK((Money(1) / Money(3)).raw() == 33);
+    CHECK((Money(2) / Money(3)).raw() == 67);
+    CHECK(Money::from_raw(1).div<rounding::nearest_even>(Money(2)).raw() == 0);
+    CHECK(Money::from_raw(1).div<rounding::nearest>(Money(2)).raw() == 1);
+    CHECK(Money::from_raw(3).div<rounding::nearest_even>(Money(2)).raw() == 2);
+    CHECK(Money::from_raw(5).mul<rounding::nearest_even>(
+            Money::from_raw(50)).raw() == 2);
+    CHECK(Money::from_raw(5).mul<rounding::nearest>(
+            Money::from_raw(50)).raw() == 3);
+}
+
+TEST_CASE("Decimal_to_chars")
+{
+    CHECK(format(D2::from_raw(0)) == "0.00");
+    CHECK(format(D2::from_raw(5)) == "0.05");
+    CHECK(format(D2::from_raw(-5)) == "-0.05");
+    CHECK(format(D2::from_raw(1999)) == "19.99");
+    CHECK(format(D2::from_raw(INT32_MIN)) == "-21474836.48");
+
+    char small[4];
+    auto result = xxint::to_chars(small, small + sizeof small,
+                                  D2::from_raw(1999));
+    CHECK(result.ec == std::errc::value_too_large);
+
+    std::ostringstream os;
+    os << Decimal<int16_t, 0>(-42);
+    CHECK(os.str() == "-42");
+}
+
+TEST_CASE("Decimal_from_chars")
+{
+    CHECK(parse<rounding::nearest_even, D2>("19.99").raw() == 1999);
+    CHECK(parse<rounding::nearest_even, D2>("-0.5").raw() == -50);
+    CHECK(parse<rounding::nearest_even, D2>(".5").raw() == 50);
+    CHECK(parse<rounding::nearest_even, D2>("7").raw() == 700);
+    CHECK(parse<rounding::nearest_even, D2>("1.125").raw() == 112);
+    CHECK(parse<rounding::nearest_even, D2>("1.1250001").raw() == 113);
+    CHECK(parse<rounding::nearest_even, D2>("1.135").raw() == 114);
+    CHECK(parse<rounding::nearest, D2>("1.125").raw() == 113);
+    CHECK(parse<rounding::floor, D2>("-1.121").raw() == -113);
+    CHECK(parse<rounding::nearest_even, D2>("-21474836.48").raw() == INT32_MIN);
+
+    CHECK_THROWS_AS((parse<rounding::nearest_even, D2>("21474836.48")),
+                    xxint::overflow_too_large);
+    CHECK_THROWS_AS((parse<rounding::nearest_even, D2>("-99999999999999999999")),
+                    xxint::overflow_too_small);
+
+    D2 partial;
+    const char* exponent = "1e9";
+    CHECK(xxint::from_chars(exponent, exponent + 3, partial).ptr == exponent + 1);
+    CHECK(partial.raw() == 100);
+
+    D2 unchanged = D2(7);
+    const char* junk = "-.x";
+    auto result = xxint::from_chars(junk, junk + 3, unchanged);
+    CHECK(result.ec == std::errc::invalid_argument);
+    CHECK(result.ptr == junk);
+    CHECK(unchanged == D2(7));
+
+    using SD2 = Decimal<int32_t, 2, policy::saturating>;
+    SD2 saturated;
+    const char* big = "99999999999999999999.99";
+    xxint::from_chars(big, big + std::strlen(big), saturated);
+    CHECK(saturated.raw() == INT32_MAX);
+}
+
+TEST_CASE("Decimal_round_trip")
+{
+    for (int32_t raw = -100000; raw <= 100000; raw += 7) {
+        auto d = D2::from_raw(raw);
+        CHECK(parse<rounding::nearest_even, D2>(format(d).c_str()) == d);
+    }
+}
@@ -0,0 +1,211 @@
+#include <delta.hxx>
+#include <catch.hxx>
+#include <climits>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using xxint::Checked;
+using xxint::delta_order;
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+
+template <class T, template <class> class P>
+Bytes pack(const std::vector<Checked<T, P>>& values, delta_order order,
+           std::size_t block_size = 128)
+{
+    Bytes result(xxint::max_packed_bytes<T>(values.size(), block_size));
+    auto r = xxint::pack_column(result.data(), result.data() + result.size(),
+                                values.data(), values.size(), order,
+                                block_size);
+    REQUIRE(r.ec == std::errc());
+    result.resize(std::size_t(r.ptr - result.data()));
+    return result;
+}
+
+template <class T, template <class> class P = xxint::policy::throwing>
+std::vector<Checked<T, P>> unpack(const Bytes& bytes, std::size_t size)
+{
+    std::vector<Checked<T, P>> result(size);
+    auto r = xxint::unpack_column(bytes.data(), bytes.data() + bytes.size(),
+                                  result.data(), result.size());
+    REQUIRE(r.ec == std::errc());
+    CHECK(r.ptr == bytes.data() + bytes.size());
+    CHECK(r.count == size);
+    return result;
+}
+
+// Columns that suit each order, and some that suit none.
+template <class T>
+std::vector<std::vector<Checked<T>>> columns(unsigned seed)
+{
+    using U = xxint::detail::make_unsigned_t<T>;
+    using limits = xxint::detail::int_traits<T>;
+
+    std::mt19937_64 rng(seed);
+    std::vector<std::vector<Checked<T>>> result(5);
+    U walk = U(rng()), step = U(rng() % 100), tick = U(rng());
+
+    for (int i = 0; i < 1000; ++i) {
+        // Random values, a random walk, a steady tick with jitter, the
+        // extremes, and a walk that crosses the top of the range.
+        result[0].emplace_back(static_cast<T>(U(rng())));
+        walk = U(walk + U(rng() % 64) - U(32));
+        result[1].emplace_back(static_cast<T>(walk));
+        tick = U(tick + step + U(rng() % 3));
+        result[2].emplace_back(static_cast<T>(tick));
+        result[3].emplace_back(i % 3 == 0 ? limits::min() : limits::max());
+        result[4].emplace_back(static_cast<T>(U(U(limits::max()) - 50 + i)));
+    }
+
+    return result;
+}
+
+template <class T>
+void check_round_trips(unsigned seed)
+{
+    for (const auto& column : columns<T>(seed)) {
+        for (auto order : {delta_order::none, delta_order::delta,
+                           delta_order::delta_of_delta}) {
+            for (std::size_t block : {1, 7, 8, 128, 1000}) {
+                auto bytes = pack(column, order, block);
+                CHECK((unpack<T>(bytes, column.size()) == column));
+            }
+        }
+    }
+}
+
+}
+
+TEST_CASE("pack_column round trip")
+{
+    check_round_trips<int8_t>(1);
+    check_round_trips<uint8_t>(2);
+    check_round_trips<int16_t>(3);
+    check_round_trips<int32_t>(4);
+    check_round_trips<uint32_t>(5);
+    check_round_trips<int64_t>(6);
+    check_round_trips<uint64_t>(7);
+#ifdef XXINT_HAS_INT128
+    check_round_trips<xxint::detail::int128_t>(8);
+#endif
+
+    std::vector<Checked<int>> empty;
+    CHECK(pack(empty, delta_order::delta).empty());
+}
+
+TEST_CASE("pack_column size")
+{
+    // Millisecond timestamps a second apart, 8192 bytes raw, take 17 bits
+    // each as offsets from their block's least value, 2 as deltas, and 3
+    // as deltas of deltas, which are not quite constant either.
+    std::vector<Checked<int64_t>> times;
+    for (int64_t i = 0; i < 1024; ++i)
+        times.emplace_back(1600000000000 + 1000 * i + i % 2);
+
+    CHECK(pack(times, delta_order::none).size() < 8192 / 3);
+    CHECK(pack(times, delta_order::delta).size() < 8192 / 10);
+    CHECK(pack(times, delta_order::delta_of_delta, 1024).size() < 8192 / 16);
+
+    // Deltas that would wrap fall back to the values.
+    std::vector<Checked<int8_t>> jumps{-128, 127, -128, 127};
+    auto bytes = pack(jumps, delta_order::delta);
+    CHECK(bytes[0] == 0);
+    CHECK((unpack<int8_t>(bytes, 4) == jumps));
+}
+
+TEST_CASE("pack_column errors")
+{
+    std::vector<Checked<int>> values(100, 5);
+    uint8_t small[8];
+    CHECK(xxint::pack_column(small, small + sizeof small, values.data(),
+                             values.size(), delta_order::delta).ec
+          == std::errc::value_too_large);
+    CHECK(xxint::pack_column(small, small + sizeof small, values.data(),
+                             values.size(), delta_order::delta, 0).ec
+          == std::errc::invalid_argument);
+
+    auto bytes = pack(values, delta_order::delta, 30);
+    std::vector<Checked<int>> out(100);
+
+    // Stops before a block that does not fit.
+    auto result = xxint::unpack_column(bytes.data(),
+                                       bytes.data() + bytes.size(),
+                                       out.data(), 70);
+    CHECK(result.count == 60);
+    CHECK(result.ec == std::errc());
+
+    // Truncated.
+    result = xxint::unpack_column(bytes.data(),
+                                  bytes.data() + bytes.size() - 1,
+                                  out.data(), out.size());
+    CHECK(result.count == 90);
+    CHECK(result.ec == std::errc::invalid_argument);
+
+    // Out of range header fields.
+    for (auto field : {0, 1}) {
+        Bytes bad = bytes;
+        bad[std::size_t(field)] = 99;
+        result = xxint::unpack_column(bad.data(), bad.data() + bad.size(),
+                                      out.data(), out.size());
+        CHECK(result.count == 0);
+        CHECK(result.ptr == bad.data());
+        CHECK(result.ec == std::errc::invalid_argument);
+    }
+}
+
+// A corrupted block cannot produce values beyond the encoded type's range:
+// its sums are checked, and the policy decides.
+TEST_CASE("unpack_column corrupted")
+{
+    // One block of deltas of 1 up to `INT_MAX - 1`, stored as its first
+    // value, then the least delta.
+    std::vector<Checked<int>> values;
+    for (int i = 0; i < 100; ++i)
+        values.emplace_back(INT_MAX - 100 + i);
+    auto bytes = pack(values, delta_order::delta);
+    REQUIRE(bytes[0] == 1);
+    REQUIRE(bytes[1] == 0);
+
+    const std::size_t ref = xxint::detail::block_header_bytes + 4;
+    bytes[ref] = 2;
+
+    CHECK_THROWS_AS(unpack<int>(bytes, 100), xxint::overflow_too_large);
+
+    auto saturated = unpack<int, xxint::policy::saturating>(bytes, 100);
+    CHECK(saturated[49] == INT_MAX - 2);
+    CHECK(saturated[50] == INT_MAX);
+    CHECK(saturated[99] == INT_MAX);
+
+    auto wrapped = unpack<int, xxint::policy::wrapping>(bytes, 100);
+    CHECK(wrapped[51] == INT_MIN + 1);
+
+    // A block of second differences whose first value has been overwritten
+    // with the greatest value, so that the second value does not fit.
+    std::vector<Checked<int64_t>> steps{0, 10, 20, 30};
+    auto corrupt = pack(steps, delta_order::delta_of_delta);
+    REQUIRE(corrupt[0] == 2);
+    for (std::size_t i = 0; i < 8; ++i)
+        corrupt[xxint::detail::block_header_bytes + i] = i < 7 ? 0xFF : 0x7F;
+
+    CHECK_THROWS_AS(unpack<int64_t>(corrupt, 4), xxint::overflow_too_large);
+
+    auto clamped = unpack<int64_t, xxint::policy::saturating>(corrupt, 4);
+    CHECK(clamped[0] == INT64_MAX);
+    CHECK(clamped[1] == INT64_MAX);
+    CHECK(clamped[3] == INT64_MAX);
+
+    auto wrapped_steps = unpack<int64_t, xxint::policy::wrapping>(corrupt, 4);
+    CHECK(wrapped_steps[1] == INT64_MIN + 9);
+
+    // Sums near the edge of the range that do fit are exact, whether or
+    // not the whole block can be shown to fit up front.
+    std::vector<Checked<int>> edge;
+    for (int i = 0; i < 100; ++i)
+        edge.emplace_back(i % 2 ? INT_MAX : INT_MAX - 100);
+    CHECK((unpack<int>(pack(edge, delta_order::delta), 100) == edge));
+    CHECK((unpack<int>(pack(edge, delta_order::delta_of_delta), 100)
+           == edge));
+}
@@ -0,0 +1,163 @@
+#include <fields.hxx>
+#include <catch.hxx>
+#include <climits>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using xxint::Checked;
+using xxint::parse_fields;
+
+namespace {
+
+// Parses all of `text` into as many `Checked<T, P>` as it has fields.
+template <class T, template <class> class P = xxint::policy::throwing>
+std::vector<Checked<T, P>> parse(const std::string& text, char delimiter,
+                                 std::vector<std::size_t>& bad)
+{
+    std::vector<Checked<T, P>> out(text.size() + 1, Checked<T, P>(T(7)));
+    auto result = parse_fields(text.data(), text.data() + text.size(),
+                               delimiter, out.data(), out.size(), bad);
+    out.resize(result.count);
+    return out;
+}
+
+}
+
+TEST_CASE("parse_fields")
+{
+    std::vector<std::size_t> bad;
+
+    auto out = parse<long>("1,-22,333,0,-0,12345678,123456789", ',', bad);
+    CHECK(out == (std::vector<Checked<long>>{1, -22, 333, 0, 0, 12345678,
+                                             123456789}));
+    CHECK(bad.empty());
+
+    out = parse<long>("9223372036854775807\n-9223372036854775808\n"
+                      "0000000000000000000000042\n", '\n', bad);
+    CHECK(out == (std::vector<Checked<long>>{LONG_MAX, LONG_MIN, 42}));
+
+    CHECK(parse<long>("", ',', bad).empty());
+    CHECK(parse<long>(",", ',', bad).size() == 1);
+    CHECK(bad == std::vector<std::size_t>{0});
+}
+
+TEST_CASE("parse_fields bad fields")
+{
+    std::vector<std::size_t> bad;
+
+    auto out = parse<int>("5,,x,-,+3,12a,6, 7,8", ',', bad);
+    CHECK(out.size() == 9);
+    CHECK(bad == (std::vector<std::size_t>{1, 2, 3, 4, 5, 7}));
+    CHECK(out[0] == 5);
+    CHECK(out[1] == 7);
+    CHECK(out[6] == 6);
+    CHECK(out[8] == 8);
+}
+
+TEST_CASE("parse_fields overflow")
+{
+    std::vector<std::size_t> bad;
+
+    CHECK_THROWS_AS(parse<long>("1,9223372036854775808", ',', bad),
+                    xxint::overflow_too_large);
+    CHECK_THROWS_AS(parse<unsigned>("-1", ',', bad),
+                    xxint::overflow_too_small);
+    CHECK_THROWS_AS(parse<long>("100000000000000000000000", ',', bad),
+                    xxint::overflow_too_large);
+
+    auto sat = parse<int8_t, xxint::policy::saturating>(
+            "127,128,-128,-129,99999999999", ',', bad);
+    CHECK(sat == (std::vector<xxint::Saturating<int8_t>>{
+            127, 127, -128, -128, 127}));
+
+    auto wrap = parse<uint16_t, xxint::policy::wrapping>("65537,-1", ',', bad);
+    CHECK(wrap == (std::vector<xxint::Wrapping<uint16_t>>{1, 65535}));
+    CHECK(bad.empty());
+}
+
+TEST_CASE("parse_fields output size")
+{
+    std::string text = "1 2 3 4";
+    std::vector<Checked<int>> out(3);
+    std::vector<std::size_t> bad;
+
+    auto result = parse_fields(text.data(), text.data() + text.size(), ' ',
+                               out.data(), out.size(), bad);
+    CHECK(result.count == 3);
+    CHECK(result.ptr == text.data() + 6);
+    CHECK(out[2] == 3);
+}
+
+// Random fields of every length, against `from_chars` one at a time.
+TEST_CASE("parse_fields random")
+{
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int> length(1, 24);
+    std::uniform_int_distribution<int> digit(0, 9);
+
+    std::string text;
+    for (int i = 0; i < 5000; ++i) {
+        if (i % 3 == 0) text += '-';
+        int n = length(rng);
+        for (int j = 0; j < n; ++j) text += char('0' + digit(rng));
+        text += '\n';
+    }
+
+    auto check = [&](auto tag) {
+        using C = decltype(tag);
+        std::vector<std::size_t> bad;
+        std::vector<C> out(5000);
+        auto result = parse_fields(text.data(), text.data() + text.size(),
+                                   '\n', out.data(), out.size(), bad);
+        CHECK(result.count == 5000);
+        CHECK(bad.empty());
+
+        int failures = 0;
+        const char* p = text.data();
+        for (auto each : out) {
+            C expected;
+            p = xxint::from_chars(p, text.data() + text.size(), expected).ptr;
+            failures += each != expected;
+            ++p;
+        }
+        CHECK(failures == 0);
+    };
+
+    check(xxint::Saturating<long>());
+    check(xxint::Saturating<uint32_t>());
+    check(xxint::Wrapping<uint64_t>());
+    check(xxint::Saturating<int16_t>());
+#ifdef XXINT_HAS_INT128
+    check(xxint::Saturating<xxint::detail::int128_t>());
+#endif
+}
+
+TEST_CASE("format_fields")
+{
+    std::vector<Checked<long>> values{0, -1, 42, LONG_MIN, LONG_MAX};
+    char buffer[64];
+
+    auto result = xxint::format_fields(buffer, buffer + sizeof buffer,
+                                       values.data(), values.size(), ',');
+    CHECK(result.count == 5);
+    CHECK(std::string(buffer, result.ptr)
+          == "0,-1,42,-9223372036854775808,9223372036854775807,");
+
+    std::vector<std::size_t> bad;
+    std::vector<Checked<long>> back(5);
+    parse_fields(buffer, result.ptr, ',', back.data(), back.size(), bad);
+    CHECK(back == values);
+
+    // Stops before a value that does not fit with its delimiter.
+    result = xxint::format_fields(buffer, buffer + 8, values.data(),
+                                  values.size(), ',');
+    CHECK(result.count == 3);
+    CHECK(std::string(buffer, result.ptr) == "0,-1,42,");
+
+    result = xxint::format_fields(buffer, buffer + 7, values.data(),
+                                  values.size(), ',');
+    CHECK(result.count == 2);
+    CHECK(std::string(buffer, result.ptr) == "0,-1,");
+}
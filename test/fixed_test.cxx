@@ -0,0 +1,138 @@
+#include <fixed.hxx>
+#include <catch.hxx>
+#include <cmath>
+#include <cstdint>
+
+using xxint::Fixed;
+using xxint::rounding;
+namespace policy = xxint::policy;
+
+using Q16 = Fixed<int32_t, 16>;
+using SQ16 = Fixed<int32_t, 16, policy::saturating>;
+
+TEST_CASE("Fixed_construction")
+{
+    CHECK(Q16(3).raw() == 3 << 16);
+    CHECK(Q16(-3).raw() == -(3 << 16));
+    CHECK(Q16(3).to_int() == 3);
+    CHECK(Q16(3).to_double() == 3.0);
+    CHECK(Q16::from_raw(1 << 15).to_double() == 0.5);
+    CHECK_THROWS_AS(Q16(1 << 15), xxint::overflow_too_large);
+    CHECK_THROWS_AS(Q16(-(1 << 15) - 1), xxint::overflow_too_small);
+    CHECK(SQ16(1 << 15).raw() == INT32_MAX);
+}
+
+TEST_CASE("Fixed_to_int_rounding")
+{
+    auto x = Q16::from_raw(-(5 << 15));   // -2.5
+
+    CHECK(x.to_int<rounding::toward_zero>() == -2);
+    CHECK(x.to_int<rounding::floor>() == -3);
+    CHECK(x.to_int<rounding::ceil>() == -2);
+    CHECK(x.to_int<rounding::nearest>() == -3);
+    CHECK(x.to_int<rounding::nearest_even>() == -2);
+    CHECK((-x).to_int<rounding::nearest>() == 3);
+    CHECK((-x).to_int<rounding::nearest_even>() == 2);
+}
+
+TEST_CASE("Fixed_arithmetic")
+{
+    auto a = Q16::from_raw(3 << 15);      // 1.5
+    auto b = Q16::from_raw(5 << 15);      // 2.5
+
+    CHECK((a + b).to_double() == 4.0);
+    CHECK((a - b).to_double() == -1.0);
+    CHECK((a * b).to_double() == 3.75);
+    CHECK((a * -b).to_double() == -3.75);
+    CHECK((b / a).raw() == 109227);       // 5/3 * 2^16 = 109226.67
+    CHECK((Q16(1) / Q16(3)).raw() == 21845);
+    CHECK((Q16(1) / Q16(3)).raw() == (Q16(1).div<rounding::floor>(Q16(3))).raw());
+    CHECK((Q16(-1) / Q16(3)).raw() == -21845);
+    CHECK((Q16(-1).div<rounding::floor>(Q16(3))).raw() == -21846);
+
+    CHECK_THROWS_AS(Q16(200) * Q16(200), xxint::overflow_too_large);
+    CHECK_THROWS_AS(Q16(200) * Q16(-200), xxint::overflow_too_small);
+    CHECK_THROWS_AS(Q16(1) / Q16(0), xxint::overflow_div_zero);
+    CHECK(SQ16(200) * SQ16(200) == SQ16::from_raw(INT32_MAX));
+    CHECK(SQ16(200) * SQ16(-200) == SQ16::from_raw(INT32_MIN));
+    CHECK(SQ16(200) / SQ16::from_raw(1) == SQ16::from_raw(INT32_MAX));
+}
+
+TEST_CASE("Fixed_convert")
+{
+    auto x = Q16::from_raw(0x18000);      // 1.5
+
+    CHECK((x.convert<int16_t, 8>().raw() == 0x180));
+    CHECK((x.convert<int64_t, 32>().raw() == 0x180000000LL));
+    CHECK((Q16::from_raw(0x18080).convert<int16_t, 8>().raw() == 0x181));
+    CHECK((Q16::from_raw(0x18080)
+                   .convert<int16_t, 8, policy::throwing, rounding::floor>()
+                   .raw() == 0x180));
+    CHECK_THROWS_AS((Q16(200).convert<int16_t, 8>()),
+                    xxint::overflow_too_large);
+    CHECK_THROWS_AS((Q16(200).convert<int32_t, 24>()),
+                    xxint::overflow_too_large);
+    CHECK((SQ16(200).convert<int16_t, 8>().raw() == INT16_MAX));
+}
+
+#ifdef XXINT_HAS_INT128
+TEST_CASE("Fixed_64_bit")
+{
+    using Q32 = Fixed<int64_t, 32>;
+
+    auto big = Q32(1LL << 20) + Q32::from_raw(1);
+    CHECK((big * Q32(2)).raw() == (1LL << 53) + 2);
+    CHECK((big / Q32(2)).raw() == (1LL << 51) + 1);
+    CHECK_THROWS_AS(big * big, xxint::overflow_too_large);
+}
+#endif
+
+// Compares multiplication and division in Q3.4 against a floating-point
+// reference for every pair of operands; every intermediate is exact in
+// `double`, so the reference rounds correctly.
+template <rounding R>
+static double reference_round(double x)
+{
+    switch (R) {
+    case rounding::toward_zero:  return std::trunc(x);
+    case rounding::floor:        return std::floor(x);
+    case rounding::ceil:         return std::ceil(x);
+    case rounding::nearest:      return std::round(x);
+    case rounding::nearest_even: return std::nearbyint(x);
+    }
+    return x;
+}
+
+template <rounding R>
+static int exhaustive_q3_4()
+{
+    using Q = Fixed<int8_t, 4, policy::saturating>;
+    int failures = 0;
+
+    for (int a = INT8_MIN; a <= INT8_MAX; ++a) {
+        for (int b = INT8_MIN; b <= INT8_MAX; ++b) {
+            auto qa = Q::from_raw(int8_t(a)), qb = Q::from_raw(int8_t(b));
+
+            double product = reference_round<R>(a * b / 16.0);
+            product = std::max(-128.0, std::min(127.0, product));
+            failures += qa.template mul<R>(qb).raw().get() != product;
+
+            if (b != 0) {
+                double quotient = reference_round<R>(a * 16.0 / b);
+                quotient = std::max(-128.0, std::min(127.0, quotient));
+                failures += qa.template div<R>(qb).raw().get() != quotient;
+            }
+        }
+    }
+
+    return failures;
+}
+
+TEST_CASE("Fixed_exhaustive_rounding")
+{
+    CHECK(0 == exhaustive_q3_4<rounding::toward_zero>());
+    CHECK(0 == exhaustive_q3_4<rounding::floor>());
+    CHECK(0 == exhaustive_q3_4<rounding::ceil>());
+    CHECK(0 == exhaustive_q3_4<rounding::nearest>());
+    CHECK(0 == exhaustive_q3_4<rounding::nearest_even>());
+}
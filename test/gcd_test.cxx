@@ -0,0 +1,114 @@
+#include <gcd.hxx>
+#include <catch.hxx>
+#include <cstdint>
+#include <random>
+
+using xxint::Checked;
+using xxint::Saturating;
+
+static unsigned euclid(unsigned a, unsigned b)
+{
+    while (b != 0) {
+        unsigned t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+TEST_CASE("bit_counting")
+{
+    using xxint::detail::countr_zero;
+    using xxint::detail::bit_width;
+
+    CHECK(countr_zero(uint8_t(0x80)) == 7);
+    CHECK(countr_zero(uint64_t(1) << 63) == 63);
+    CHECK(bit_width(uint8_t(0)) == 0);
+    CHECK(bit_width(uint16_t(0x1234)) == 13);
+    CHECK(bit_width(UINT64_MAX) == 64);
+#ifdef XXINT_HAS_INT128
+    using xxint::detail::uint128_t;
+    CHECK(countr_zero(uint128_t(1) << 100) == 100);
+    CHECK(bit_width(uint128_t(1) << 100) == 101);
+    CHECK(bit_width(uint128_t(5)) == 3);
+#endif
+}
+
+TEST_CASE("gcd_exhaustive_8_bit")
+{
+    int failures = 0;
+
+    for (int a = -128; a < 128; ++a) {
+        for (int b = -128; b < 128; ++b) {
+            unsigned expected = euclid(unsigned(std::abs(a)), unsigned(std::abs(b)));
+            failures += xxint::gcd(int8_t(a), int8_t(b)) != expected;
+            failures += xxint::gcd(uint8_t(a), uint8_t(b))
+                        != euclid(uint8_t(a), uint8_t(b));
+        }
+    }
+
+    CHECK(failures == 0);
+}
+
+TEST_CASE("gcd_checked")
+{
+    using C = Checked<int>;
+
+    CHECK(xxint::gcd(C(-12), C(18)) == C(6));
+    CHECK(xxint::gcd(C(0), C(-7)) == C(7));
+    CHECK(xxint::gcd(C(0), C(0)) == C(0));
+    CHECK(xxint::gcd(C(INT_MIN), C(6)) == C(2));
+    CHECK_THROWS_AS(xxint::gcd(C(INT_MIN), C(0)), xxint::overflow_too_large);
+    CHECK(xxint::gcd(Saturating<int>(INT_MIN), Saturating<int>(INT_MIN))
+          == INT_MAX);
+    CHECK(xxint::gcd(INT_MIN, 0) == 1u << 31);
+
+    CHECK(xxint::lcm(C(4), C(-6)) == C(12));
+    CHECK(xxint::lcm(C(0), C(5)) == C(0));
+    CHECK(xxint::lcm(C(65536), C(32768)) == C(65536));
+    CHECK_THROWS_AS(xxint::lcm(C(65536), C(65537)), xxint::overflow_too_large);
+    CHECK_THROWS_AS(xxint::lcm(C(INT_MIN), C(1)), xxint::overflow_too_large);
+    CHECK(xxint::lcm(Saturating<int>(65536), Saturating<int>(65537)) == INT_MAX);
+}
+
+#ifdef XXINT_HAS_INT128
+TEST_CASE("gcd_lehmer")
+{
+    using xxint::detail::uint128_t;
+    using xxint::detail::binary_gcd;
+
+    std::mt19937_64 rng(128);
+    // A nonzero random number below 2^bits.
+    auto random = [&](int bits) {
+        uint128_t x = uint128_t(rng()) << 64 | rng();
+        x >>= 128 - bits;
+        return x == 0 ? uint128_t(1) : x;
+    };
+
+    int failures = 0;
+
+    for (int i = 0; i < 20000; ++i) {
+        int gbits = int(rng() % 64) + 1;
+        int cbits = int(rng() % (128 - gbits)) + 1;
+        uint128_t g = random(gbits);
+        uint128_t a = g * random(cbits), b = g * random(int(rng() % cbits) + 1);
+
+        uint128_t expected = binary_gcd(a, b);
+        failures += xxint::gcd(a, b) != expected;
+        failures += xxint::gcd(b, a) != expected;
+        failures += a % expected != 0 || b % expected != 0;
+    }
+
+    // Consecutive Fibonacci numbers are the worst case for Euclid.
+    uint128_t f0 = 0, f1 = 1;
+    for (int i = 0; i < 180; ++i) {
+        uint128_t t = f0 + f1;
+        f0 = f1;
+        f1 = t;
+    }
+    failures += xxint::gcd(f1, f0) != 1;
+    failures += xxint::gcd(f1 * 3, f0 * 3) != 3;
+
+    CHECK(failures == 0);
+}
+#endif
@@ -1,5 +1,9 @@
 #include <xxint.hxx>
+#include "HybridRational.hxx"
 #include <gmpxx.h>
+// Needed by rapidcheck's Random.h, which does not include them.
+#include <functional>
+#include <ostream>
 #include <rapidcheck.h>
 #include <cstdint>
 
@@ -235,8 +239,66 @@ struct Check_comparisons
     }
 };
 
+using rational::HybridRational;
+using Q = mpq_class;
+
+// Whether `h` has the value `q`, and is small exactly when that fits.
+bool same(const HybridRational& h, const Q& q)
+{
+    bool fits = q.get_num().fits_slong_p() && q.get_den().fits_slong_p();
+    return h.to_mpq() == q && h.is_small() == fits;
+}
+
+Q make_q(long n, long d)
+{
+    Q result{Z(n), Z(d)};
+    result.canonicalize();
+    return result;
+}
+
+void check_hybrid_rational()
+{
+    rc::check("HybridRational arithmetic",
+              [](long a, long b, long c, long d) {
+                  RC_PRE(b != 0 && d != 0);
+                  HybridRational x(a, b), y(c, d);
+                  Q qx = make_q(a, b), qy = make_q(c, d);
+
+                  RC_ASSERT(same(x, qx));
+                  RC_ASSERT(same(x + y, qx + qy));
+                  RC_ASSERT(same(x - y, qx - qy));
+                  RC_ASSERT(same(x * y, qx * qy));
+                  RC_ASSERT(same(-x, -qx));
+                  if (c != 0) RC_ASSERT(same(x / y, qx / qy));
+                  RC_ASSERT((x < y) == (qx < qy));
+                  RC_ASSERT((x == y) == (qx == qy));
+                  return true;
+              });
+
+    rc::check("HybridRational promotes and demotes",
+              [](long a, long b, long c) {
+                  RC_PRE(b != 0 && c != 0);
+                  HybridRational x(a, b), y(c, LONG_MAX);
+                  Q qx = make_q(a, b), qy = make_q(c, LONG_MAX);
+
+                  HybridRational product = x * y * y * y;
+                  RC_ASSERT(same(product, qx * qy * qy * qy));
+                  HybridRational back = product / y / y / y;
+                  RC_ASSERT(same(back, qx));
+                  RC_ASSERT(back == x);
+
+                  HybridRational sum = x + y;
+                  sum += HybridRational(LONG_MAX) * HybridRational(LONG_MAX);
+                  sum -= HybridRational(LONG_MAX) * HybridRational(LONG_MAX);
+                  RC_ASSERT(same(sum, qx + qy));
+                  return true;
+              });
+}
+
 int main()
 {
+    check_hybrid_rational();
+
     apply_to_types<Check_operations>();
     apply_to_types<Check_conversions>();
     apply_to_types<Check_comparisons>();
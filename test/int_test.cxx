@@ -1,6 +1,11 @@
 #include <xxint.hxx>
 #include <catch.hxx>
+#include <algorithm>
+#include <bitset>
+#include <cstring>
 #include <sstream>
+#include <string>
+#include <unordered_set>
 
 using xxint::Wrapping;
 using W = Wrapping<int>;
@@ -308,3 +313,247 @@ TEST_CASE("Wrapping_print") {
     CHECK("-1" == os.str());
 }
 
+
+TEST_CASE("Checked_to_chars") {
+    auto format = [](auto value) {
+        char buffer[48];
+        auto result = xxint::to_chars(buffer, buffer + sizeof buffer, value);
+        return std::string(buffer, result.ptr);
+    };
+
+    CHECK(format(Checked<int>(0)) == "0");
+    CHECK(format(Checked<long>(LONG_MIN)) == "-9223372036854775808");
+    CHECK(format(Checked<unsigned long>(ULONG_MAX)) == "18446744073709551615");
+    CHECK(format(Checked<int8_t>(-128)) == "-128");
+    CHECK(format(Wrapping<uint8_t>(255)) == "255");
+
+    // Around every power of ten, against the standard library.
+    int failures = 0;
+    for (unsigned long power = 1; power <= ULONG_MAX / 10; power *= 10) {
+        for (unsigned long each : {power - 1, power, power + 1}) {
+            failures += format(Checked<unsigned long>(each))
+                        != std::to_string(each);
+            failures += format(Checked<long>(-long(each)))
+                        != std::to_string(-long(each));
+        }
+    }
+    CHECK(failures == 0);
+
+    char small[3];
+    auto result = xxint::to_chars(small, small + 3, Checked<int>(-123));
+    CHECK(result.ec == std::errc::value_too_large);
+    CHECK(result.ptr == small + 3);
+}
+
+TEST_CASE("Checked_from_chars") {
+    auto parse = [](const char* text, auto& value) {
+        return xxint::from_chars(text, text + std::strlen(text), value).ec;
+    };
+
+    Checked<long> l;
+    CHECK(parse("-9223372036854775808", l) == std::errc());
+    CHECK(l == LONG_MIN);
+    CHECK(parse("0009223372036854775807", l) == std::errc());
+    CHECK(l == LONG_MAX);
+    CHECK_THROWS_AS(parse("9223372036854775808", l),
+                    xxint::overflow_too_large);
+    CHECK_THROWS_AS(parse("-9223372036854775809", l),
+                    xxint::overflow_too_small);
+    CHECK_THROWS_AS(parse("99999999999999999999999", l),
+                    xxint::overflow_too_large);
+
+    const char text[] = "42abc";
+    auto result = xxint::from_chars(text, text + 5, l);
+    CHECK(l == 42);
+    CHECK(result.ptr == text + 2);
+
+    for (const char* bad : {"", "-", "+1", " 1", "x"}) {
+        CHECK(parse(bad, l) == std::errc::invalid_argument);
+        CHECK(l == 42);
+    }
+
+    Checked<unsigned> u;
+    CHECK(parse("-0", u) == std::errc());
+    CHECK(u == 0u);
+    CHECK_THROWS_AS(parse("-1", u), xxint::overflow_too_small);
+
+    xxint::Saturating<int8_t> s;
+    parse("300", s);
+    CHECK(s == 127);
+    parse("-300", s);
+    CHECK(s == -128);
+
+    Wrapping<uint8_t> w;
+    parse("257", w);
+    CHECK(w == 1);
+    parse("-1", w);
+    CHECK(w == 255);
+
+    // Every value of a narrow type round-trips, and the neighbours just
+    // outside its range are found to overflow.
+    int failures = 0;
+    for (int i = -129; i <= 128; ++i) {
+        xxint::Saturating<int8_t> value;
+        std::string digits = std::to_string(i);
+        parse(digits.c_str(), value);
+        failures += value.get() != std::max(-128, std::min(127, i));
+    }
+    CHECK(failures == 0);
+}
+
+TEST_CASE("Checked_extraction") {
+    std::istringstream in(" 12 -7 +3 99999999999 x");
+    Checked<int> a, b, c;
+
+    in >> a >> b >> c;
+    CHECK(a == 12);
+    CHECK(b == -7);
+    CHECK(c == 3);
+    CHECK_THROWS_AS(in >> a, xxint::overflow_too_large);
+
+    in >> a;
+    CHECK(in.fail());
+    CHECK(a == 12);
+
+    std::istringstream end("5");
+    Checked<int8_t> small;
+    end >> small;
+    CHECK(small == 5);
+    CHECK(end.eof());
+    CHECK(!end.fail());
+}
+
+TEST_CASE("mul_wide") {
+    using xxint::mul_wide;
+
+    int failures = 0;
+    for (int a = -128; a < 128; ++a) {
+        for (int b = -128; b < 128; ++b) {
+            auto p = mul_wide(int8_t(a), int8_t(b));
+            failures += p.high * 256 + p.low != a * b;
+
+            auto q = mul_wide(uint8_t(a), uint8_t(b));
+            failures += q.high * 256 + q.low != (a & 0xFF) * (b & 0xFF);
+        }
+    }
+    CHECK(failures == 0);
+
+    auto p = mul_wide(Checked<int64_t>(INT64_MIN), Checked<int64_t>(-1));
+    CHECK(p.high == 0);
+    CHECK(p.low == uint64_t(1) << 63);
+
+    auto q = mul_wide(UINT64_MAX, UINT64_MAX);
+    CHECK(q.high == UINT64_MAX - 1);
+    CHECK(q.low == 1);
+
+    constexpr auto r = mul_wide(W(-3), W(5));
+    static_assert(r.high == -1 && r.low == unsigned(-15), "");
+
+#ifdef XXINT_HAS_INT128
+    using xxint::detail::int128_t;
+    using xxint::detail::uint128_t;
+
+    auto m = mul_wide(int64_t(-123456789012345), int64_t(987654321098765));
+    CHECK((int128_t(uint128_t(m.high) << 64 | m.low)
+           == int128_t(-123456789012345) * 987654321098765));
+
+    // No wider type, so this takes the schoolbook path.
+    auto n = mul_wide(-(int128_t(1) << 100), int128_t(3) << 28);
+    CHECK((n.high == -3));
+    CHECK((n.low == 0));
+
+    uint128_t max = ~uint128_t(0);
+    auto o = mul_wide(max, max);
+    CHECK((o.high == max - 1));
+    CHECK((o.low == 1));
+#endif
+}
+
+TEST_CASE("mul_high") {
+    using xxint::detail::mul_high;
+
+    CHECK(mul_high<uint8_t>(0xFF, 0xFF) == 0xFE);
+    CHECK(mul_high<uint32_t>(0x80000000u, 4) == 2);
+    CHECK(mul_high<uint64_t>(UINT64_MAX, UINT64_MAX) == UINT64_MAX - 1);
+#ifdef XXINT_HAS_INT128
+    using xxint::detail::uint128_t;
+    uint128_t max = ~uint128_t(0);
+    CHECK((mul_high<uint128_t>(max, max) == max - 1));
+    CHECK((mul_high<uint128_t>(uint128_t(1) << 127, 6) == 3));
+#endif
+}
+
+TEST_CASE("add_carry_sub_borrow") {
+    using xxint::add_carry;
+    using xxint::sub_borrow;
+
+    bool carry = false;
+    CHECK(add_carry(uint8_t(200), uint8_t(100), false, carry) == 44);
+    CHECK(carry);
+    CHECK(add_carry(uint8_t(255), uint8_t(0), true, carry) == 0);
+    CHECK(carry);
+    CHECK(add_carry(uint8_t(1), uint8_t(2), true, carry) == 4);
+    CHECK(!carry);
+
+    bool borrow = false;
+    CHECK(sub_borrow(uint8_t(0), uint8_t(0), true, borrow) == 255);
+    CHECK(borrow);
+    CHECK(sub_borrow(uint8_t(5), uint8_t(5), false, borrow) == 0);
+    CHECK(!borrow);
+
+    // 128-bit arithmetic from 64-bit words.
+    uint64_t a[2] = {UINT64_MAX, 1}, b[2] = {1, 2}, c[2];
+    carry = false;
+    c[0] = add_carry(a[0], b[0], carry, carry);
+    c[1] = add_carry(a[1], b[1], carry, carry);
+    CHECK(c[0] == 0);
+    CHECK(c[1] == 4);
+    CHECK(!carry);
+
+    borrow = false;
+    c[0] = sub_borrow(b[0], a[0], borrow, borrow);
+    c[1] = sub_borrow(b[1], a[1], borrow, borrow);
+    CHECK(c[0] == 2);
+    CHECK(c[1] == 0);
+    CHECK(!borrow);
+
+    using CU = Checked<unsigned>;
+    CHECK(add_carry(CU(UINT_MAX), CU(1), false, carry) == CU(0));
+    CHECK(carry);
+    CHECK(sub_borrow(CU(0), CU(1), false, borrow) == CU(UINT_MAX));
+    CHECK(borrow);
+}
+
+TEST_CASE("hash") {
+    std::hash<C> hash_int;
+    std::hash<Checked<long>> hash_long;
+    std::hash<Checked<unsigned char, xxint::policy::saturating>> hash_byte;
+
+    CHECK(hash_int(C(-1)) == hash_long(Checked<long>(-1)));
+    CHECK(hash_int(C(200)) == hash_byte(200));
+    CHECK(hash_int(C(0)) != hash_int(C(1)));
+
+    // Every bit of the input should flip about half of the output bits.
+    uint64_t flipped = 0, trials = 0;
+    for (long x = 1; x < 100000; x = x * 3 + 1) {
+        for (int bit = 0; bit < 64; ++bit) {
+            auto change = hash_long(x) ^ hash_long(x ^ (1L << bit));
+            flipped += std::bitset<64>(change).count();
+            ++trials;
+        }
+    }
+    CHECK(flipped > trials * 30);
+    CHECK(flipped < trials * 34);
+
+    std::unordered_set<C> set;
+    for (int i = 0; i < 1000; ++i) set.insert(C(i % 100));
+    CHECK(set.size() == 100);
+
+#ifdef XXINT_HAS_INT128
+    using xxint::detail::int128_t;
+    std::hash<Checked<int128_t>> hash_128;
+    CHECK(hash_128(int128_t(-5)) == hash_long(-5));
+    CHECK(hash_128(int128_t(1) << 64) != hash_128(1));
+    CHECK(hash_128(int128_t(1) << 64) != hash_128(0));
+#endif
+}
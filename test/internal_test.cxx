@@ -82,3 +82,21 @@ TEST_CASE("goes_higher_than")
     CHECK_FALSE(goes_higher_than<  int16_t,   int64_t>());
 }
 
+
+TEST_CASE("byte_swap")
+{
+    CHECK(byte_swap(uint8_t(0x12)) == 0x12);
+    CHECK(byte_swap(uint16_t(0x1234)) == 0x3412);
+    CHECK(byte_swap(uint32_t(0x12345678)) == 0x78563412);
+    CHECK(byte_swap(0x0123456789ABCDEFull) == 0xEFCDAB8967452301ull);
+
+    const uint8_t bytes[] = {1, 2, 3, 4, 5, 6, 7, 8};
+    CHECK(load_be<uint64_t>(bytes) == 0x0102030405060708);
+    CHECK(load_le<uint64_t>(bytes) == 0x0807060504030201);
+    CHECK(load_be<uint16_t>(bytes + 6) == 0x0708);
+
+#ifdef XXINT_HAS_INT128
+    auto high = uint128_t(0x0123456789ABCDEF) << 64;
+    CHECK((byte_swap(high) == 0xEFCDAB8967452301));
+#endif
+}
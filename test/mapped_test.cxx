@@ -0,0 +1,164 @@
+#include <mapped.hxx>
+#include <catch.hxx>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <system_error>
+#include <vector>
+
+using xxint::Checked;
+
+TEST_CASE("convert_values")
+{
+    // More than a chunk, where the values pass `INT16_MAX` in the second.
+    std::vector<int64_t> in(1500);
+    for (std::size_t i = 0; i < in.size(); ++i)
+        in[i] = int64_t(i) * 50 - 30000;
+
+    std::vector<xxint::Saturating<int16_t>> saturated(in.size());
+    xxint::convert_values(in.data(), in.size(), saturated.data());
+    CHECK(saturated[0] == -30000);
+    CHECK(saturated[1499] == INT16_MAX);
+    for (std::size_t i = 0; i < in.size(); ++i)
+        CHECK(saturated[i] == xxint::convert_sat<int16_t>(in[i]));
+
+    std::vector<Checked<int16_t>> checked(in.size());
+    CHECK_NOTHROW(xxint::convert_values(in.data(), 512, checked.data()));
+    CHECK(checked[511] == in[511]);
+    CHECK_THROWS_AS(xxint::convert_values(in.data(), in.size(),
+                                          checked.data()),
+                    xxint::overflow_too_large);
+
+    std::vector<xxint::Wrapping<int16_t>> wrapped(in.size());
+    xxint::convert_values(in.data(), in.size(), wrapped.data());
+    CHECK(wrapped[1499] == int16_t(in[1499]));
+}
+
+namespace {
+
+// Converting in bulk agrees with `Convert`, whichever type is signed.
+template <class To, class From>
+void check_convert_values()
+{
+    using limits = xxint::detail::int_traits<From>;
+
+    std::vector<From> in;
+    for (int i = -40; i < 40; ++i) {
+        in.push_back(static_cast<From>(i));
+        in.push_back(static_cast<From>(limits::max() - From(i % 8 + 8)));
+        in.push_back(static_cast<From>(limits::min() + From(i % 8 + 8)));
+    }
+
+    std::vector<xxint::Saturating<To>> out(in.size());
+    xxint::convert_values(in.data(), in.size(), out.data());
+    for (std::size_t i = 0; i < in.size(); ++i)
+        CHECK(out[i].get() == xxint::convert_sat<To>(in[i]));
+}
+
+}
+
+TEST_CASE("convert_values signedness")
+{
+    check_convert_values<int32_t, int64_t>();
+    check_convert_values<uint32_t, int64_t>();
+    check_convert_values<int32_t, uint64_t>();
+    check_convert_values<uint64_t, int64_t>();
+    check_convert_values<int64_t, uint64_t>();
+    check_convert_values<int8_t, uint8_t>();
+    check_convert_values<int64_t, uint32_t>();
+    check_convert_values<int64_t, int16_t>();
+}
+
+#ifdef XXINT_HAS_MMAP
+
+namespace {
+
+// A temporary file holding `values` as little-endian bytes.
+class Temp_file
+{
+public:
+    explicit Temp_file(const std::vector<int64_t>& values, std::size_t extra = 0)
+    {
+        int fd = ::mkstemp(path_);
+        REQUIRE(fd >= 0);
+
+        std::vector<uint8_t> bytes(8 * values.size() + extra);
+        for (std::size_t i = 0; i < values.size(); ++i)
+            xxint::detail::store_le(&bytes[8 * i], uint64_t(values[i]));
+        REQUIRE(::write(fd, bytes.data(), bytes.size())
+                == ssize_t(bytes.size()));
+        ::close(fd);
+    }
+
+    ~Temp_file() { std::remove(path_); }
+
+    const char* path() const { return path_; }
+
+private:
+    char path_[32] = "/tmp/xxint_mapped_XXXXXX";
+};
+
+}
+
+TEST_CASE("mapped_column")
+{
+    std::vector<int64_t> values;
+    for (int64_t i = 0; i < 3000; ++i)
+        values.push_back(i % 1000 == 999 ? INT64_MIN + i : i * i - 1000);
+
+    Temp_file file(values);
+    xxint::mapped_column<> column(file.path());
+
+    REQUIRE(column.size() == values.size());
+    CHECK(column[0] == -1000);
+    CHECK(column[999] == INT64_MIN + 999);
+#ifdef XXINT_LITTLE_ENDIAN
+    CHECK(std::vector<int64_t>(column.begin(), column.end()) == values);
+#endif
+
+    // Chunk by chunk, as a column too large for memory would be read.
+    std::vector<xxint::Saturating<int32_t>> out(700);
+    std::size_t first = 0;
+    while (std::size_t n = column.read(first, out.data(), out.size())) {
+        for (std::size_t i = 0; i < n; ++i)
+            CHECK(out[i] == xxint::convert_sat<int32_t>(values[first + i]));
+        first += n;
+    }
+    CHECK(first == values.size());
+    CHECK(column.read(first, out.data(), out.size()) == 0);
+
+    std::vector<Checked<int32_t>> checked(1000);
+    CHECK(column.read(0, checked.data(), 999) == 999);
+    CHECK(checked[998] == 998 * 998 - 1000);
+    CHECK_THROWS_AS(column.read(0, checked.data(), 1000),
+                    xxint::overflow_too_small);
+
+    auto moved = std::move(column);
+    CHECK(moved.size() == values.size());
+    CHECK(column.empty());
+
+    // Assigning replaces the mapping and empties the source.
+    Temp_file other_file(std::vector<int64_t>{7, 8});
+    xxint::mapped_column<> other(other_file.path());
+    moved = std::move(other);
+    CHECK(moved.size() == 2);
+    CHECK(moved[1] == 8);
+    CHECK(other.empty());
+}
+
+TEST_CASE("mapped_column errors")
+{
+    Temp_file empty({});
+    CHECK(xxint::mapped_column<>(empty.path()).empty());
+
+    // A partial value.
+    Temp_file ragged({1, 2}, 3);
+    CHECK_THROWS_AS(xxint::mapped_column<>(ragged.path()), std::system_error);
+    CHECK(xxint::mapped_column<uint8_t>(ragged.path()).size() == 19);
+
+    CHECK_THROWS_AS(xxint::mapped_column<>("/nonexistent/column"),
+                    std::system_error);
+    CHECK_THROWS_AS(xxint::mapped_column<>("/tmp"), std::system_error);
+}
+
+#endif // XXINT_HAS_MMAP
@@ -0,0 +1,126 @@
+#include "Matrix.hxx"
+#include <catch.hxx>
+#include <climits>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using R = rational::Rational<>;
+using M = rational::Matrix<>;
+using rational::determinant;
+using rational::rank;
+using rational::solve;
+
+namespace {
+
+// Determinant by Gaussian elimination over `Rational`, for comparison.
+R naive_determinant(M const& a)
+{
+    std::size_t n = a.rows();
+    std::vector<std::vector<R>> m(n, std::vector<R>(n));
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t j = 0; j < n; ++j)
+            m[i][j] = R(a(i, j).get());
+
+    R result(1);
+    for (std::size_t k = 0; k < n; ++k) {
+        std::size_t p = k;
+        while (p < n && m[p][k] == R(0)) ++p;
+        if (p == n) return R(0);
+        if (p != k) {
+            std::swap(m[p], m[k]);
+            result = -result;
+        }
+
+        result *= m[k][k];
+        for (std::size_t i = k + 1; i < n; ++i) {
+            R factor = m[i][k] / m[k][k];
+            for (std::size_t j = k; j < n; ++j)
+                m[i][j] -= factor * m[k][j];
+        }
+    }
+
+    return result;
+}
+
+}
+
+TEST_CASE("matrix determinant")
+{
+    CHECK(determinant(M{{2, 1}, {1, 3}}) == R(5));
+    CHECK(determinant(M{{0, 1}, {1, 0}}) == R(-1));
+    CHECK(determinant(M{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}) == R(0));
+    CHECK(determinant(M{{0, 2, 1}, {0, 1, 4}, {3, 5, 7}}) == R(21));
+    CHECK(determinant(M(0, 0)) == R(1));
+    CHECK_THROWS_AS(determinant(M(2, 3)), std::invalid_argument);
+    CHECK_THROWS_AS((M{{1, 2}, {3}}), std::invalid_argument);
+}
+
+TEST_CASE("matrix rank")
+{
+    CHECK(rank(M{{1, 2, 3}, {2, 4, 6}, {1, 0, 1}}) == 2);
+    CHECK(rank(M{{0, 0, 1, 2}, {0, 0, 2, 4}}) == 1);
+    CHECK(rank(M{{0, 1}, {0, 0}, {1, 0}}) == 2);
+    CHECK(rank(M(3, 4)) == 0);
+}
+
+TEST_CASE("matrix solve")
+{
+    auto x = solve(M{{2, 1}, {1, 3}}, {3, 5});
+    CHECK(x == (std::vector<R>{R(4, 5), R(7, 5)}));
+
+    x = solve(M{{0, 2, 1}, {0, 1, 4}, {3, 5, 7}}, {1, 0, -1});
+    CHECK(x == (std::vector<R>{R(-20, 21), R(4, 7), R(-1, 7)}));
+
+    CHECK_THROWS_AS(solve(M{{1, 2}, {2, 4}}, {1, 1}), std::domain_error);
+    CHECK_THROWS_AS(solve(M{{1, 2}, {2, 4}}, {1}), std::invalid_argument);
+}
+
+// Intermediates that overflow `T` are redone in the double-width type, and
+// only the results are narrowed by the policy.
+TEST_CASE("matrix overflow")
+{
+    using M8 = rational::Matrix<xxint::Checked<int8_t>>;
+    CHECK(determinant(M8{{12, 11}, {11, 12}}).numerator() == 23);
+    CHECK(rank(M8{{100, 99}, {99, 98}}) == 2);
+
+    const long big = 1L << 40;
+    M a{{big, 1}, {1, big}};
+    CHECK_THROWS_AS(determinant(a), xxint::overflow_too_large);
+    CHECK(solve(a, {big + 2, 2 * big + 1}) == (std::vector<R>{R(1), R(2)}));
+
+    using MS = rational::Matrix<xxint::Checked<long, xxint::policy::saturating>>;
+    CHECK(determinant(MS{{big, 1}, {1, big}}).numerator() == LONG_MAX);
+}
+
+TEST_CASE("matrix random")
+{
+    std::mt19937_64 rng(6);
+    std::uniform_int_distribution<long> entry(-9, 9);
+    const std::size_t n = 6;
+
+    for (int trial = 0; trial < 100; ++trial) {
+        M a(n, n);
+        std::vector<xxint::Checked<long>> b(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            // Some rows repeat, so that some matrices are singular.
+            for (std::size_t j = 0; j < n; ++j)
+                a(i, j) = i > 0 && trial % 4 == 0 ? a(i - 1, j) : entry(rng);
+            b[i] = entry(rng);
+        }
+
+        R det = determinant(a);
+        CHECK(det == naive_determinant(a));
+        CHECK((rank(a) == n) == (det != R(0)));
+        if (det == R(0)) continue;
+
+        auto x = solve(a, b);
+        for (std::size_t i = 0; i < n; ++i) {
+            R sum;
+            for (std::size_t j = 0; j < n; ++j)
+                sum += R(a(i, j).get()) * x[j];
+            CHECK(sum == R(b[i].get()));
+        }
+    }
+}
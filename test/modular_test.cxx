@@ -0,0 +1,118 @@
+#include <modular.hxx>
+#include <catch.hxx>
+#include <cstdint>
+#include <sstream>
+
+using xxint::Modular;
+using xxint::Modulus;
+using xxint::DynamicModular;
+
+using Z7 = Modular<uint32_t, 1000000007>;
+
+TEST_CASE("Modular_arithmetic")
+{
+    CHECK(Z7(5).get() == 5);
+    CHECK(Z7(-1).get() == 1000000006);
+    CHECK(Z7(1000000008LL).get() == 1);
+    CHECK(Z7(xxint::Checked<long>(-3)).get() == 1000000004);
+    CHECK((Z7(1000000006) + Z7(5)).get() == 4);
+    CHECK((Z7(3) - Z7(5)).get() == 1000000005);
+    CHECK((-Z7(0)).get() == 0);
+    CHECK((Z7(123456789) * Z7(987654321)).get()
+          == 123456789ULL * 987654321ULL % 1000000007);
+    CHECK(Z7(2).pow(1000000006) == Z7(1));
+    CHECK(Z7(3).pow(0) == Z7(1));
+    CHECK(Z7(3).pow(-1) * Z7(3) == Z7(1));
+    CHECK(Z7(10) / Z7(5) == Z7(2));
+
+    CHECK(Z7::from_residue(1000000006).get() == 1000000006);
+    CHECK_THROWS_AS(Z7::from_residue(1000000007), xxint::overflow_too_large);
+    CHECK_THROWS_AS(Z7(0).inverse(), xxint::overflow_div_zero);
+
+    std::ostringstream os;
+    os << Z7(-2);
+    CHECK(os.str() == "1000000005");
+}
+
+TEST_CASE("Modular_even")
+{
+    using Z = Modular<uint64_t, 1ULL << 40>;
+    using Z6 = Modular<uint16_t, 6>;
+
+    CHECK((Z(1ULL << 39) * Z(2)).get() == 0);
+    CHECK((Z((1ULL << 40) - 1) * Z((1ULL << 40) - 1)).get() == 1);
+    CHECK(Z(3).inverse() * Z(3) == Z(1));
+    CHECK_THROWS_AS(Z(2).inverse(), xxint::overflow_div_zero);
+    CHECK(Z6(5).inverse() == Z6(5));
+    CHECK_THROWS_AS(Z6(3).inverse(), xxint::overflow_div_zero);
+}
+
+TEST_CASE("Modular_64_bit")
+{
+    const uint64_t p = (1ULL << 61) - 1;
+    using Z = Modular<uint64_t, (1ULL << 61) - 1>;
+    using ZMax = Modular<uint64_t, UINT64_MAX>;
+
+    CHECK(Z(3).pow(p - 1) == Z(1));
+    CHECK(Z(p - 1) * Z(p - 1) == Z(1));
+    CHECK(Z(12345).inverse() * Z(12345) == Z(1));
+    CHECK((ZMax(UINT64_MAX - 1) * ZMax(UINT64_MAX - 1)).get() == 1);
+    CHECK((ZMax(UINT64_MAX - 1) + ZMax(UINT64_MAX - 1)).get()
+          == UINT64_MAX - 2);
+}
+
+TEST_CASE("Modulus_validation")
+{
+    CHECK_THROWS_AS(Modulus<uint32_t>(1), xxint::overflow_too_small);
+    CHECK_THROWS_AS(Modulus<uint32_t>(0), xxint::overflow_too_small);
+}
+
+TEST_CASE("DynamicModular")
+{
+    Modulus<uint64_t> m(998244353);
+    using D = DynamicModular<uint64_t>;
+
+    D x(m, 3);
+    CHECK(x.pow(998244352).get() == 1);
+    CHECK((x * x.inverse()).get() == 1);
+    CHECK(D(m, -1).get() == 998244352);
+    CHECK_THROWS_AS(D::from_residue(m, 998244353), xxint::overflow_too_large);
+
+    Modulus<uint64_t> other(1000000007);
+    CHECK_THROWS_AS(x + D(other, 1), std::invalid_argument);
+    CHECK(x != D(other, 3));
+}
+
+// Every product, sum, difference and inverse for every 8-bit modulus,
+// covering both Montgomery (odd) and Barrett (even) reduction.
+TEST_CASE("Modulus_exhaustive_8_bit")
+{
+    int failures = 0;
+
+    for (unsigned mod = 2; mod <= 255; ++mod) {
+        Modulus<uint8_t> m{uint8_t(mod)};
+
+        for (unsigned a = 0; a < mod; ++a) {
+            uint8_t ra = m.from_integer(a);
+            failures += m.get(ra) != a;
+
+            for (unsigned b = 0; b < mod; ++b) {
+                uint8_t rb = m.from_integer(b);
+                failures += m.get(m.mul(ra, rb)) != a * b % mod;
+                failures += m.get(m.add(ra, rb)) != (a + b) % mod;
+                failures += m.get(m.sub(ra, rb)) != (a + mod - b) % mod;
+            }
+
+            try {
+                uint8_t inv = m.inverse(ra);
+                failures += m.get(m.mul(ra, inv)) != 1;
+            } catch (xxint::overflow_div_zero&) {
+                unsigned g = mod, h = a;
+                while (h != 0) { unsigned t = g % h; g = h; h = t; }
+                failures += g == 1;
+            }
+        }
+    }
+
+    CHECK(failures == 0);
+}
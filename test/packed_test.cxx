@@ -0,0 +1,129 @@
+#include <packed.hxx>
+#include <catch.hxx>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using xxint::PackedArray;
+
+namespace {
+
+// Packing and unpacking at every offset agrees with setting and getting
+// one value at a time.
+template <class T, int Bits>
+void check_round_trip(unsigned seed)
+{
+    using Array = PackedArray<T, Bits>;
+
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<int64_t> dist(Array::min(), Array::max());
+
+    std::vector<xxint::Checked<T>> values;
+    for (int i = 0; i < 100; ++i)
+        values.emplace_back(static_cast<T>(dist(rng)));
+    values[3] = Array::min();
+    values[4] = Array::max();
+
+    Array one(values.size());
+    for (std::size_t i = 0; i < values.size(); ++i)
+        one.set(i, values[i]);
+    for (std::size_t i = 0; i < values.size(); ++i)
+        REQUIRE(one[i] == values[i]);
+
+    for (std::size_t first : {0, 1, 8, 13}) {
+        std::size_t count = values.size() - first - first / 2;
+
+        Array bulk(values.size());
+        bulk.pack(first, values.data() + first, count);
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            bool packed = i >= first && i < first + count;
+            CHECK(bulk[i] == (packed ? values[i] : 0));
+        }
+
+        std::vector<xxint::Checked<T>> out(count);
+        one.unpack(first, out.data(), count);
+        CHECK((out == std::vector<xxint::Checked<T>>(
+                values.begin() + long(first),
+                values.begin() + long(first + count))));
+    }
+}
+
+}
+
+TEST_CASE("PackedArray round trip")
+{
+    check_round_trip<uint8_t, 5>(1);
+    check_round_trip<int8_t, 5>(2);
+    check_round_trip<int8_t, 8>(3);
+    check_round_trip<uint16_t, 9>(4);
+    check_round_trip<int16_t, 12>(5);
+    check_round_trip<int32_t, 17>(6);
+    check_round_trip<uint32_t, 20>(7);
+    check_round_trip<int32_t, 32>(8);
+    check_round_trip<uint32_t, 32>(9);
+    check_round_trip<int64_t, 1>(10);
+}
+
+TEST_CASE("PackedArray size")
+{
+    CHECK((PackedArray<int16_t, 12>::min() == -2048));
+    CHECK((PackedArray<int16_t, 12>::max() == 2047));
+    CHECK((PackedArray<uint16_t, 12>::max() == 4095));
+
+    // 1000 12-bit values in 1500 bytes, and a word of slack.
+    PackedArray<int16_t, 12> a(1000);
+    CHECK(a.size() == 1000);
+    CHECK(a[999] == 0);
+
+    // Neighbours are untouched.
+    a.set(500, -1);
+    CHECK(a[499] == 0);
+    CHECK(a[500] == -1);
+    CHECK(a[501] == 0);
+    CHECK(a.bytes()[750] == 0xFF);
+    CHECK(a.bytes()[751] == 0x0F);
+}
+
+TEST_CASE("PackedArray policies")
+{
+    // Like narrowing to a built-in type of 12 bits.
+    PackedArray<int16_t, 12> checked(4);
+    CHECK_THROWS_AS(checked.set(0, 2048), xxint::overflow_too_large);
+    CHECK_THROWS_AS(checked.set(0, -2049), xxint::overflow_too_small);
+    CHECK_THROWS_AS(checked.set(0, 100000), xxint::overflow_too_large);
+    CHECK_THROWS_AS(checked.set(0, xxint::Checked<long>(-5000)),
+                    xxint::overflow_too_small);
+    checked.set(0, -2048);
+    CHECK(checked[0] == -2048);
+
+    PackedArray<int16_t, 12, xxint::policy::saturating> saturated(3);
+    saturated.set(0, 5000);
+    saturated.set(1, -100000);
+    saturated.set(2, 7);
+    CHECK(saturated[0] == 2047);
+    CHECK(saturated[1] == -2048);
+    CHECK(saturated[2] == 7);
+
+    PackedArray<uint8_t, 5, xxint::policy::wrapping> wrapped(2);
+    wrapped.set(0, 33);
+    wrapped.set(1, -1);
+    CHECK(wrapped[0] == 1);
+    CHECK(wrapped[1] == 31);
+
+    PackedArray<uint16_t, 9> unsigned_checked(1);
+    CHECK_THROWS_AS(unsigned_checked.set(0, -1), xxint::overflow_too_small);
+    CHECK_THROWS_AS(unsigned_checked.set(0, 512), xxint::overflow_too_large);
+
+    // A group with a value out of range goes through the policy.
+    std::vector<int> values{1, 2, 3, 4000, -4000, 6, 7, 8, 9};
+    PackedArray<int16_t, 12, xxint::policy::saturating> group(9);
+    group.pack(0, values.data(), values.size());
+    CHECK(group[2] == 3);
+    CHECK(group[3] == 2047);
+    CHECK(group[4] == -2048);
+    CHECK(group[8] == 9);
+
+    PackedArray<int16_t, 12> throwing(9);
+    CHECK_THROWS_AS(throwing.pack(0, values.data(), values.size()),
+                    xxint::overflow_too_large);
+}
@@ -1,8 +1,16 @@
 #include "Rational.hxx"
 #include <catch.hxx>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <sstream>
 #include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
-using R = rational::Rational;
+using R = rational::Rational<>;
 
 TEST_CASE("rational multiplication")
 {
@@ -14,3 +22,422 @@ TEST_CASE("rational multiplication overflow")
 {
     CHECK_THROWS_AS(R(LONG_MAX, 3) * R(5), std::overflow_error);
 }
+
+TEST_CASE("rational normalization")
+{
+    CHECK(R(6, -4).numerator() == -3);
+    CHECK(R(6, -4).denominator() == 2);
+    CHECK(R(0, -5) == R(0));
+    CHECK(R(LONG_MIN, LONG_MIN) == R(1));
+    CHECK(R(LONG_MIN, 2).numerator() == LONG_MIN / 2);
+    CHECK_THROWS_AS(R(LONG_MIN, -1), std::overflow_error);
+}
+
+TEST_CASE("rational reciprocal")
+{
+    CHECK(R(-2, 3).reciprocal() == R(-3, 2));
+    CHECK(R(-2, 3).reciprocal().denominator() == 2);
+    CHECK(R(1) / R(-4) == R(-1, 4));
+}
+
+// Every sum and product of pairs from a grid of numerators and
+// denominators that spans the 8-bit range, against the same computation in
+// `long`.
+TEST_CASE("rational 8-bit arithmetic grid")
+{
+    using R8 = rational::Rational<xxint::Checked<int8_t>>;
+
+    std::vector<std::pair<R8, R>> values;
+    for (int n = -128; n < 128; n += 3)
+        for (int d = 1; d < 128; d += 9)
+            values.emplace_back(R8(int8_t(n), int8_t(d)), R(n, d));
+
+    auto same = [](R8 a, R b) {
+        return a.numerator() == b.numerator()
+               && a.denominator() == b.denominator();
+    };
+
+    int failures = 0;
+    for (auto a : values) {
+        for (auto b : values) {
+            R sum = a.second + b.second, product = a.second * b.second;
+            bool sum_fits = sum.numerator() >= -128 && sum.numerator() < 128
+                            && sum.denominator() < 128;
+            bool product_fits = product.numerator() >= -128
+                                && product.numerator() < 128
+                                && product.denominator() < 128;
+            try {
+                R8 result = a.first + b.first;
+                failures += !sum_fits || !same(result, sum);
+            } catch (std::overflow_error&) {
+                failures += sum_fits;
+            }
+            try {
+                R8 result = a.first * b.first;
+                failures += !product_fits || !same(result, product);
+            } catch (std::overflow_error&) {
+                failures += product_fits;
+            }
+        }
+    }
+
+    CHECK(failures == 0);
+}
+
+#ifdef XXINT_HAS_INT128
+TEST_CASE("rational without a wider type")
+{
+    using xxint::detail::int128_t;
+    using R128 = rational::Rational<xxint::Checked<int128_t>>;
+
+    int128_t big = int128_t(1) << 100;
+    CHECK((R128(big, 3) * R128(3, big) == R128(1)));
+    CHECK((R128(1, big) + R128(1, big) == R128(1, big / 2)));
+    CHECK_THROWS_AS(R128(big) * R128(big), std::overflow_error);
+    CHECK((R128(big - 1, big) < R128(big, big - 1)));
+    CHECK((R128(-big, big - 1) < R128(-(big - 1), big)));
+}
+#endif
+
+TEST_CASE("rational comparison")
+{
+    CHECK(R(-1, 2) < R(1, 3));
+    CHECK(R(0) < R(1, LONG_MAX));
+    CHECK(R(-1, LONG_MAX) < R(0));
+    CHECK(!(R(0) < R(0)));
+    CHECK(R(LONG_MAX - 1, LONG_MAX) < R(LONG_MAX, LONG_MAX - 1));
+    CHECK(R(LONG_MAX - 2, LONG_MAX - 1) < R(LONG_MAX - 1, LONG_MAX));
+    CHECK(R(-(LONG_MAX - 1), LONG_MAX - 2) < R(-LONG_MAX, LONG_MAX - 1));
+    CHECK(R(LONG_MIN, 3) < R(LONG_MIN + 1, 3));
+    CHECK(R(1, LONG_MAX) < R(LONG_MAX));
+    CHECK(R(5, 4) >= R(5, 4));
+}
+
+// Every pair from a grid of numerators and denominators that spans the
+// 8-bit range.
+TEST_CASE("rational 8-bit comparison grid")
+{
+    using R8 = rational::Rational<xxint::Checked<int8_t>>;
+
+    std::vector<R8> values;
+    for (int n = -128; n < 128; n += 5)
+        for (int d = 1; d < 128; d += 7)
+            values.emplace_back(int8_t(n), int8_t(d));
+
+    int failures = 0;
+    for (auto a : values) {
+        for (auto b : values) {
+            bool expected = a.numerator() * b.denominator()
+                            < b.numerator() * a.denominator();
+            failures += (a < b) != expected;
+        }
+    }
+
+    CHECK(failures == 0);
+}
+
+TEST_CASE("rational fast paths")
+{
+    CHECK(R(3) + R(4) == R(7));
+    CHECK(R(3) * R(-4) == R(-12));
+    CHECK(R(6) * R(5, 4) == R(15, 2));
+    CHECK(R(5, 4) * R(0) == R(0));
+    CHECK(R(4) * R(1, 4) == R(1));
+    CHECK(R(2) + R(1, 3) == R(7, 3));
+    CHECK(R(1, 3) + R(-1) == R(-2, 3));
+    CHECK(R(1, 4) + R(1, 4) == R(1, 2));
+    CHECK(R(1, 4) + R(-1, 4) == R(0));
+    CHECK(R(LONG_MAX, 2) + R(LONG_MAX, 2) == R(LONG_MAX));
+    CHECK_THROWS_AS(R(LONG_MAX) + R(1), std::overflow_error);
+    CHECK_THROWS_AS(R(LONG_MAX) * R(2), std::overflow_error);
+    CHECK_THROWS_AS(R(LONG_MAX, 2) + R(LONG_MAX), std::overflow_error);
+
+    R r(-1, 3);
+    CHECK(++r == R(2, 3));
+    CHECK(r++ == R(2, 3));
+    CHECK(r == R(5, 3));
+    CHECK(--r == R(2, 3));
+    CHECK(--r == R(-1, 3));
+    CHECK(r.denominator() == 3);
+}
+
+TEST_CASE("rational accumulator")
+{
+    rational::RationalAccumulator<> harmonic;
+    R sum;
+    for (long k = 1; k <= 40; ++k) {
+        harmonic += R(1, k);
+        sum += R(1, k);
+        CHECK(harmonic.total() == sum);
+    }
+
+    // The denominators of these cancelling terms multiply past even the
+    // wide type, so the sum has to be reduced along the way.
+    rational::RationalAccumulator<> zero;
+    for (long p = 3; p < 2000; p += 2) {
+        zero += R(1, p);
+        zero -= R(1, p);
+    }
+    CHECK(zero.total() == R(0));
+    zero += R(LONG_MIN, 3);
+    CHECK(zero.total() == R(LONG_MIN, 3));
+
+    // H(60) has a denominator too large for a long.
+    for (long k = 41; k <= 60; ++k) harmonic += R(1, k);
+    CHECK_THROWS_AS(harmonic.total(), std::overflow_error);
+    for (long k = 60; k > 40; --k) harmonic -= R(1, k);
+    CHECK(harmonic.total() == sum);
+}
+
+// Every three-term sum of some 8-bit rationals, which should throw only if
+// the total does not fit, or a partial sum does not fit in 16 bits even
+// when reduced.
+TEST_CASE("rational accumulator 8-bit")
+{
+    using R8 = rational::Rational<xxint::Checked<int8_t>>;
+
+    std::vector<std::pair<R8, R>> values;
+    for (int n = -128; n < 128; n += 37)
+        for (int d = 1; d < 128; d += 19)
+            values.emplace_back(R8(int8_t(n), int8_t(d)), R(n, d));
+
+    auto fits = [](R r, long limit) {
+        return r.numerator() >= -limit && r.numerator() < limit
+               && r.denominator() < limit;
+    };
+
+    int failures = 0;
+    for (auto a : values) {
+        for (auto b : values) {
+            for (auto c : values) {
+                R partial = a.second + b.second;
+                R sum = partial + c.second;
+                bool expected = fits(partial, 1 << 15) && fits(sum, 1 << 7);
+                try {
+                    rational::RationalAccumulator<xxint::Checked<int8_t>> acc;
+                    acc += a.first;
+                    acc += b.first;
+                    acc += c.first;
+                    R8 result = acc.total();
+                    failures += !expected
+                                || result.numerator() != sum.numerator()
+                                || result.denominator() != sum.denominator();
+                } catch (std::overflow_error&) {
+                    failures += expected;
+                }
+            }
+        }
+    }
+
+    CHECK(failures == 0);
+}
+
+static std::string format(R r)
+{
+    char buffer[64];
+    auto result = rational::to_chars(buffer, buffer + sizeof buffer, r);
+    return std::string(buffer, result.ptr);
+}
+
+static R parse(const char* s, R init = R())
+{
+    auto result = rational::from_chars(s, s + std::strlen(s), init);
+    CHECK(result.ec == std::errc());
+    CHECK(result.ptr == s + std::strlen(s));
+    return init;
+}
+
+TEST_CASE("rational to_chars")
+{
+    CHECK(format(R(0)) == "0");
+    CHECK(format(R(-7)) == "-7");
+    CHECK(format(R(6, -4)) == "-3/2");
+    CHECK(format(R(LONG_MIN, LONG_MAX)) ==
+          "-9223372036854775808/9223372036854775807");
+
+    char small[3];
+    auto result = rational::to_chars(small, small + sizeof small, R(1, 10));
+    CHECK(result.ec == std::errc::value_too_large);
+    CHECK(result.ptr == small + sizeof small);
+
+    std::ostringstream os;
+    os << R(-1, 3) << ' ' << R(4);
+    CHECK(os.str() == "-1/3 4");
+}
+
+TEST_CASE("rational from_chars")
+{
+    CHECK(parse("42") == R(42));
+    CHECK(parse("-0") == R(0));
+    CHECK(parse("6/4") == R(3, 2));
+    CHECK(parse("-10/15") == R(-2, 3));
+    CHECK(parse("1.25") == R(5, 4));
+    CHECK(parse("-.5") == R(-1, 2));
+    CHECK(parse("0.50000000000000000000000000") == R(1, 2));
+    CHECK(parse("3.000") == R(3));
+    CHECK(parse("-9223372036854775808") == R(LONG_MIN));
+    CHECK(parse("9223372036854775807/9223372036854775807") == R(1));
+
+    // Parsing stops where the syntax does.
+    const char* partial = "3/x 1.5.5 7/";
+    R r;
+    CHECK(rational::from_chars(partial, partial + 12, r).ptr == partial + 1);
+    CHECK(r == R(3));
+    CHECK(rational::from_chars(partial + 4, partial + 12, r).ptr
+          == partial + 7);
+    CHECK(r == R(3, 2));
+    CHECK(rational::from_chars(partial + 10, partial + 12, r).ptr
+          == partial + 11);
+
+    const char* junk = "-/2";
+    R unchanged(1, 3);
+    auto result = rational::from_chars(junk, junk + 3, unchanged);
+    CHECK(result.ec == std::errc::invalid_argument);
+    CHECK(result.ptr == junk);
+    CHECK(unchanged == R(1, 3));
+
+    R out;
+    const char* big = "9223372036854775808";
+    CHECK_THROWS_AS(rational::from_chars(big, big + 19, out),
+                    xxint::overflow_too_large);
+    const char* fine = "0.00000000000000000001";
+    CHECK_THROWS_AS(rational::from_chars(fine, fine + 22, out),
+                    xxint::overflow_too_large);
+    const char* zero = "1/0";
+    CHECK_THROWS_AS(rational::from_chars(zero, zero + 3, out),
+                    std::overflow_error);
+
+    using RS = rational::Rational<xxint::Checked<int8_t,
+                                                 xxint::policy::saturating>>;
+    RS saturated;
+    const char* wide = "-1000/3";
+    rational::from_chars(wide, wide + 7, saturated);
+    CHECK((saturated == RS(-128, 3)));
+
+    for (long n = -50; n <= 50; n += 7)
+        for (long d = 1; d <= 50; d += 3)
+            CHECK(parse(format(R(n, d)).c_str()) == R(n, d));
+}
+
+TEST_CASE("rational to_double")
+{
+    CHECK(to_double(R(1, 3)) == 1.0 / 3);
+    CHECK(to_double(R(-7, 2)) == -3.5);
+    CHECK(to_double(R(LONG_MAX)) == std::ldexp(1.0, 63));
+    CHECK(to_double(R(LONG_MIN, LONG_MAX)) == -1.0);
+
+    // Converting the parts first rounds twice: the quotient is above
+    // 1 + 2^-53, so it rounds up, but both parts round to 2^62.
+    long n = (1L << 62) + (1L << 9) - 1, d = (1L << 62) - (1L << 8);
+    CHECK(to_double(R(n, d)) == 1 + std::ldexp(1.0, -52));
+    CHECK(double(n) / double(d) == 1.0);
+}
+
+#ifdef XXINT_HAS_INT128
+// The exact value of a finite double, which has at most 53 significant
+// bits and, here, an exponent no lower than -120.
+static rational::Rational<xxint::Checked<xxint::detail::int128_t>>
+exact(double y)
+{
+    using xxint::detail::int128_t;
+    int e;
+    auto m = static_cast<int128_t>(std::ldexp(std::frexp(y, &e), 53));
+    e -= 53;
+    if (e >= 0) return m << e;
+    return {m, int128_t(1) << -e};
+}
+
+// Checks that to_double is correctly rounded by comparing each rational
+// exactly with the midpoints between its double and the neighbors.
+TEST_CASE("rational to_double rounding")
+{
+    using R128 = rational::Rational<xxint::Checked<xxint::detail::int128_t>>;
+
+    std::mt19937_64 rng(53);
+    int failures = 0;
+
+    for (int i = 0; i < 20000; ++i) {
+        int nbits = int(rng() % 63) + 1, dbits = int(rng() % 63) + 1;
+        long n = long(rng() >> (64 - nbits)), d = long(rng() >> (64 - dbits));
+        if (d == 0) continue;
+
+        R r(n, d);
+        double y = to_double(r);
+        R128 value(r.numerator(), r.denominator()), half(1, 2);
+        R128 low  = (exact(std::nextafter(y, 0.0)) + exact(y)) * half;
+        R128 high = (exact(std::nextafter(y, 2 * y)) + exact(y)) * half;
+
+        bool even = std::fmod(std::ldexp(std::frexp(y, &nbits), 53), 2) == 0;
+        failures += even ? value < low || high < value
+                         : value <= low || high <= value;
+    }
+
+    CHECK(failures == 0);
+}
+#endif
+
+TEST_CASE("rational from_double")
+{
+    using rational::from_double;
+
+    const double pi = 3.14159265358979323846;
+
+    CHECK(from_double(0.75) == R(3, 4));
+    CHECK(from_double(-0.1, 10) == R(-1, 10));
+    CHECK(from_double(0.0) == R(0));
+    CHECK(from_double(3.0) == R(3));
+    CHECK(from_double(pi, 1) == R(3));
+    CHECK(from_double(pi, 7) == R(22, 7));
+    CHECK(from_double(pi, 106) == R(333, 106));
+    CHECK(from_double(pi, 113) == R(355, 113));
+    CHECK(from_double(pi, 1000) == R(355, 113));
+    CHECK(from_double(1.0 / 3) == R(6004799503160661, 18014398509481984));
+    CHECK(from_double(1e-30, 1000) == R(0));
+    CHECK(from_double(std::ldexp(1.0, -62)) == R(1, 1L << 62));
+    CHECK(from_double(std::ldexp(1.0, -64)) == R(0));
+    CHECK(from_double(std::ldexp(3.0, -64)) == R(1, 6148914691236517205));
+    CHECK(from_double(std::ldexp(3.0, 61)) == R(3L << 61));
+    CHECK(from_double(1e10 + 0.25, 3) == R(30000000001, 3));
+    CHECK(from_double(1e10 + 0.5, 2) == R(20000000001, 2));
+    CHECK(from_double(1e10 + 0.25, 2) == R(10000000000));
+    CHECK(from_double(1e18 + 128, 10) == R(1000000000000000128L));
+
+    // The exact value of a double round-trips, and bounded results are
+    // no farther than the continued-fraction convergents allow.
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+    for (int i = 0; i < 1000; ++i) {
+        double x = dist(rng);
+        CHECK(to_double(from_double(x)) == x);
+        R approx = from_double(x, 1000);
+        CHECK(approx.denominator() <= 1000);
+        CHECK(std::fabs(to_double(approx) - x) < 1.0 / 1000);
+    }
+
+    CHECK_THROWS_AS(from_double(NAN), std::invalid_argument);
+    CHECK_THROWS_AS(from_double(1.0, 0), std::invalid_argument);
+    CHECK_THROWS_AS(from_double(std::ldexp(1.0, 63)),
+                    xxint::overflow_too_large);
+    CHECK_THROWS_AS(from_double(-INFINITY), xxint::overflow_too_small);
+
+    using R8 = rational::Rational<xxint::Checked<int8_t>>;
+    CHECK((from_double<xxint::Checked<int8_t>>(0.3) == R8(3, 10)));
+    CHECK((from_double<xxint::Checked<int8_t>>(-127.9) == R8(-127)));
+    CHECK((from_double<xxint::Checked<int8_t>>(1.0 / 200) == R8(1, 127)));
+}
+
+TEST_CASE("rational hash")
+{
+    std::hash<R> hash;
+    CHECK(hash(R(2, 4)) == hash(R(-3, -6)));
+    CHECK(hash(R(1, 2)) != hash(R(2, 1)));
+    CHECK(hash(R(0)) != hash(R(1)));
+
+    // Exact-ratio deduplication.
+    std::unordered_map<R, int> counts;
+    for (long n = 1; n <= 30; ++n)
+        for (long d = 1; d <= 30; ++d)
+            ++counts[R(n, d)];
+    CHECK(counts.size() == 555);
+    CHECK(counts[R(1)] == 30);
+}
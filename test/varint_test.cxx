@@ -0,0 +1,248 @@
+#include <varint.hxx>
+#include <catch.hxx>
+#include <climits>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using xxint::Checked;
+using xxint::Saturating;
+using xxint::Wrapping;
+using xxint::decode_varint;
+using xxint::encode_varint;
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+
+template <class T, template <class> class P>
+Bytes encode(Checked<T, P> value)
+{
+    Bytes result(xxint::max_varint_bytes<T>());
+    auto end = encode_varint(result.data(), result.data() + result.size(),
+                             value).ptr;
+    result.resize(std::size_t(end - result.data()));
+    return result;
+}
+
+template <class T, template <class> class P = xxint::policy::throwing>
+Checked<T, P> decode(const Bytes& bytes)
+{
+    Checked<T, P> result;
+    auto r = decode_varint(bytes.data(), bytes.data() + bytes.size(), result);
+    REQUIRE(r.ec == std::errc());
+    CHECK(r.ptr == bytes.data() + bytes.size());
+    return result;
+}
+
+// Values of every bit length, and their negations if `T` is signed.
+template <class T>
+std::vector<Checked<T>> random_values(std::size_t count, unsigned seed)
+{
+    using U = xxint::detail::make_unsigned_t<T>;
+    constexpr int width = xxint::detail::int_traits<U>::width;
+
+    std::mt19937_64 rng(seed);
+    std::vector<Checked<T>> result;
+    for (std::size_t i = 0; i < count; ++i) {
+        U bits = U(rng());
+        if (width > 64) bits = U(bits << (width / 2) ^ U(rng()));
+        result.emplace_back(static_cast<T>(U(bits >> (i % width))));
+    }
+    return result;
+}
+
+// Encodes `values` in bulk and one at a time, compares, and decodes back
+// both ways.
+template <class T>
+void check_round_trip(const std::vector<Checked<T>>& values)
+{
+    Bytes bulk(values.size() * xxint::max_varint_bytes<T>());
+    auto encoded = xxint::encode_varints(bulk.data(),
+                                         bulk.data() + bulk.size(),
+                                         values.data(), values.size());
+    REQUIRE(encoded.count == values.size());
+    bulk.resize(std::size_t(encoded.ptr - bulk.data()));
+
+    Bytes single;
+    for (auto each : values) {
+        auto bytes = encode(each);
+        single.insert(single.end(), bytes.begin(), bytes.end());
+    }
+    CHECK(bulk == single);
+
+    std::vector<Checked<T>> out(values.size());
+    auto decoded = xxint::decode_varints(bulk.data(),
+                                         bulk.data() + bulk.size(),
+                                         out.data(), out.size());
+    CHECK(decoded.count == values.size());
+    CHECK(decoded.ptr == bulk.data() + bulk.size());
+    CHECK((out == values));
+
+    const uint8_t* p = bulk.data();
+    int failures = 0;
+    for (auto each : values) {
+        Checked<T> value;
+        p = decode_varint(p, bulk.data() + bulk.size(), value).ptr;
+        failures += value != each;
+    }
+    CHECK(failures == 0);
+}
+
+}
+
+TEST_CASE("zigzag")
+{
+    using xxint::zigzag_decode;
+    using xxint::zigzag_encode;
+
+    CHECK(zigzag_encode(0) == 0u);
+    CHECK(zigzag_encode(-1) == 1u);
+    CHECK(zigzag_encode(1) == 2u);
+    CHECK(zigzag_encode(-2) == 3u);
+    CHECK(zigzag_encode(INT_MAX) == UINT_MAX - 1);
+    CHECK(zigzag_encode(INT_MIN) == UINT_MAX);
+    CHECK(zigzag_encode(int8_t(-128)) == 255);
+
+    for (int i = -128; i < 128; ++i)
+        CHECK(zigzag_decode<int8_t>(zigzag_encode(int8_t(i))) == i);
+    CHECK(zigzag_decode<long>(ULONG_MAX) == LONG_MIN);
+}
+
+TEST_CASE("encode_varint")
+{
+    CHECK(encode(Checked<unsigned>(0)) == Bytes{0});
+    CHECK(encode(Checked<unsigned>(127)) == Bytes{0x7F});
+    CHECK(encode(Checked<unsigned>(128)) == (Bytes{0x80, 0x01}));
+    CHECK(encode(Checked<unsigned>(300)) == (Bytes{0xAC, 0x02}));
+    CHECK(encode(Checked<int>(-1)) == Bytes{0x01});
+    CHECK(encode(Checked<int>(-65)) == (Bytes{0x81, 0x01}));
+    CHECK(encode(Checked<uint64_t>(UINT64_MAX)).size() == 10);
+    CHECK(encode(Checked<uint8_t>(255)) == (Bytes{0xFF, 0x01}));
+
+    uint8_t buffer[2];
+    auto result = encode_varint(buffer, buffer + 2, Checked<int>(1 << 20));
+    CHECK(result.ec == std::errc::value_too_large);
+    CHECK(result.ptr == buffer + 2);
+}
+
+TEST_CASE("decode_varint")
+{
+    CHECK(decode<unsigned>(Bytes{0xAC, 0x02}) == 300u);
+    CHECK(decode<int>(Bytes{0x81, 0x01}) == -65);
+    CHECK(decode<uint64_t>(encode(Checked<uint64_t>(UINT64_MAX)))
+          == UINT64_MAX);
+    CHECK(decode<long>(encode(Checked<long>(LONG_MIN))) == LONG_MIN);
+
+    // Zero groups beyond the value are padding.
+    CHECK(decode<int>(Bytes{0x82, 0x80, 0x80, 0x00}) == 1);
+    CHECK(decode<uint8_t>(Bytes{0xFF, 0x81, 0x80, 0x80, 0x80, 0x80, 0x80,
+                                0x80, 0x80, 0x80, 0x80, 0x00}) == 255);
+
+    // Not terminated.
+    Checked<int> value(7);
+    Bytes bytes{0x80, 0x80};
+    auto result = decode_varint(bytes.data(), bytes.data() + 2, value);
+    CHECK(result.ec == std::errc::invalid_argument);
+    CHECK(result.ptr == bytes.data());
+    CHECK(value == 7);
+    CHECK(decode_varint(bytes.data(), bytes.data(), value).ec
+          == std::errc::invalid_argument);
+}
+
+// Decoding into a narrower type converts as `Convert` would, and so does a
+// value beyond the decoding word.
+TEST_CASE("decode_varint narrowing")
+{
+    auto big   = encode(Checked<long>(300));
+    auto small = encode(Checked<long>(-300));
+
+    CHECK_THROWS_AS(decode<int8_t>(big), xxint::overflow_too_large);
+    CHECK_THROWS_AS(decode<int8_t>(small), xxint::overflow_too_small);
+    CHECK((decode<int8_t, xxint::policy::saturating>(big)) == 127);
+    CHECK((decode<int8_t, xxint::policy::saturating>(small)) == -128);
+    CHECK((decode<int8_t, xxint::policy::wrapping>(big)) == 44);
+    CHECK((decode<int8_t, xxint::policy::wrapping>(small)) == -44);
+
+    auto max = encode(Checked<uint64_t>(UINT64_MAX));
+    CHECK_THROWS_AS(decode<uint32_t>(max), xxint::overflow_too_large);
+    CHECK((decode<uint32_t, xxint::policy::saturating>(max)) == UINT32_MAX);
+    CHECK((decode<uint32_t, xxint::policy::wrapping>(max)) == UINT32_MAX);
+
+    // 70 bits: too large for the 64-bit word, with the zigzag sign bit
+    // clear or set.
+    Bytes huge(9, 0xFE);
+    huge.push_back(0x7F);
+    CHECK_THROWS_AS(decode<uint64_t>(huge), xxint::overflow_too_large);
+    CHECK_THROWS_AS(decode<long>(huge), xxint::overflow_too_large);
+    CHECK((decode<long, xxint::policy::saturating>(huge)) == LONG_MAX);
+    huge[0] = 0xFF;
+    CHECK((decode<long, xxint::policy::saturating>(huge)) == LONG_MIN);
+    CHECK((decode<int16_t, xxint::policy::saturating>(huge)) == INT16_MIN);
+
+    // Wrapping keeps the low bits.
+    Bytes ones(9, 0xFF);
+    ones.push_back(0x7F);
+    CHECK((decode<uint64_t, xxint::policy::wrapping>(ones)) == UINT64_MAX);
+}
+
+TEST_CASE("varints bulk")
+{
+    check_round_trip(random_values<int8_t>(1000, 1));
+    check_round_trip(random_values<uint8_t>(1000, 2));
+    check_round_trip(random_values<int16_t>(1000, 3));
+    check_round_trip(random_values<int32_t>(1000, 4));
+    check_round_trip(random_values<uint32_t>(1000, 5));
+    check_round_trip(random_values<int64_t>(1000, 6));
+    check_round_trip(random_values<uint64_t>(1000, 7));
+#ifdef XXINT_HAS_INT128
+    check_round_trip(random_values<xxint::detail::int128_t>(1000, 8));
+    check_round_trip(random_values<xxint::detail::uint128_t>(1000, 9));
+#endif
+
+    // Mostly one-byte varints, in runs.
+    std::vector<Checked<int>> runs;
+    for (int i = 0; i < 1000; ++i)
+        runs.emplace_back(i % 17 == 0 ? i * 1000 : i % 64 - 32);
+    check_round_trip(runs);
+
+    // Bulk decoding narrows like one at a time.
+    auto wide = random_values<int32_t>(1000, 10);
+    Bytes bytes(5 * wide.size());
+    auto end = xxint::encode_varints(bytes.data(), bytes.data() + bytes.size(),
+                                     wide.data(), wide.size()).ptr;
+    std::vector<Saturating<int16_t>> narrow(wide.size());
+    xxint::decode_varints(bytes.data(), end, narrow.data(), narrow.size());
+    int failures = 0;
+    for (std::size_t i = 0; i < wide.size(); ++i)
+        failures += narrow[i] != Saturating<int16_t>(wide[i].get());
+    CHECK(failures == 0);
+}
+
+TEST_CASE("varints partial")
+{
+    std::vector<Checked<int>> values{1, 1000, -1, 1 << 30, 5};
+    Bytes bytes(5 * values.size());
+    auto encoded = xxint::encode_varints(bytes.data(),
+                                         bytes.data() + bytes.size(),
+                                         values.data(), values.size());
+    REQUIRE(encoded.count == 5);
+
+    // Stops at a varint cut off by the end of the buffer...
+    std::vector<Checked<int>> out(5);
+    auto cut = encoded.ptr - 3;
+    auto result = xxint::decode_varints(bytes.data(), cut, out.data(), 5);
+    CHECK(result.count == 3);
+    CHECK(result.ptr == bytes.data() + 4);
+
+    // ... or at the end of the output.
+    result = xxint::decode_varints(bytes.data(), encoded.ptr, out.data(), 2);
+    CHECK(result.count == 2);
+    CHECK(result.ptr == bytes.data() + 3);
+
+    // Encoding stops before a value that does not fit.
+    auto partial = xxint::encode_varints(bytes.data(), bytes.data() + 5,
+                                         values.data(), values.size());
+    CHECK(partial.count == 3);
+    CHECK(partial.ptr == bytes.data() + 4);
+}
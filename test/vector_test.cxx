@@ -0,0 +1,143 @@
+#include <vector.hxx>
+#include <catch.hxx>
+#include <climits>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using xxint::CheckedVector;
+
+namespace {
+
+// The vector's values, which must agree with `expected`.
+template <class T, template <class> class P>
+void check_values(const CheckedVector<T, P>& v,
+                  const std::vector<xxint::Checked<T, P>>& expected)
+{
+    REQUIRE(v.size() == expected.size());
+    for (std::size_t i = 0; i < v.size(); ++i)
+        CHECK(v[i] == expected[i]);
+
+    // The bounds hold.
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        CHECK(v.block_min(i / v.block_size) <= v[i].get());
+        CHECK(v.block_max(i / v.block_size) >= v[i].get());
+    }
+}
+
+}
+
+TEST_CASE("CheckedVector elements")
+{
+    CheckedVector<int> v{1, 2, 3};
+    CHECK(v.size() == 3);
+    CHECK(v.blocks() == 1);
+    CHECK(v[1] == 2);
+    CHECK(v.block_min(0) == 1);
+    CHECK(v.block_max(0) == 3);
+    CHECK(reinterpret_cast<std::uintptr_t>(v.data()) % v.alignment == 0);
+
+    for (int i = 0; i < 1000; ++i)
+        v.push_back(i - 500);
+    CHECK(v.size() == 1003);
+    CHECK(v.blocks() == 4);
+    CHECK(v[1002] == 499);
+    CHECK(v.block_min(3) == 265);
+    CHECK(v.block_max(3) == 499);
+
+    v.set(1002, -7);
+    CHECK(v[1002] == -7);
+    CHECK(v.block_min(3) == -7);
+
+    CheckedVector<int> copy = v;
+    copy.set(0, 100);
+    CHECK(v[0] == 1);
+    CHECK(copy[1002] == -7);
+
+    CheckedVector<short> filled(300, 5);
+    CHECK(filled.blocks() == 2);
+    CHECK(filled[299] == 5);
+    CHECK(CheckedVector<int>().empty());
+}
+
+TEST_CASE("CheckedVector scalar arithmetic")
+{
+    // Blocks that cannot overflow, and one that can, in the middle.
+    std::vector<xxint::Saturating<int>> expected;
+    CheckedVector<int, xxint::policy::saturating> v;
+    for (int i = 0; i < 1000; ++i) {
+        int value = i >= 256 && i < 512 && i % 10 == 0 ? INT_MAX - 5 : i;
+        expected.push_back(value);
+        v.push_back(value);
+    }
+
+    v += 100;
+    for (auto& each : expected) each = each + 100;
+    check_values(v, expected);
+    CHECK(v.overflowed(260));
+    CHECK_FALSE(v.overflowed(261));
+    CHECK_FALSE(v.overflowed(10));
+    CHECK(v.block_max(1) == INT_MAX);
+    CHECK(v.block_max(2) == 767 + 100);
+
+    v -= 50;
+    v *= -3;
+    for (auto& each : expected) each = (each - 50) * -3;
+    check_values(v, expected);
+    CHECK(v.block_min(1) == INT_MIN);
+    CHECK(v.block_max(0) == -150);
+
+    v.set(260, 0);
+    CHECK_FALSE(v.overflowed(260));
+    CHECK(v.any_overflowed());
+}
+
+TEST_CASE("CheckedVector throwing")
+{
+    CheckedVector<int8_t> v(300, 100);
+    v.set(299, -100);
+
+    v += 27;
+    CHECK(v[0] == 127);
+    CHECK(v[299] == -73);
+    CHECK_THROWS_AS(v += 1, xxint::overflow_too_large);
+
+    CheckedVector<int8_t> w(300, 2);
+    CHECK_THROWS_AS(w *= 64, xxint::overflow_too_large);
+    CHECK_THROWS_AS(v += CheckedVector<int8_t>(299), std::invalid_argument);
+
+    CheckedVector<uint16_t> u{1, 2, 3};
+    CHECK_THROWS_AS(u -= 2, xxint::overflow_too_small);
+    CHECK_FALSE(u.any_overflowed());
+}
+
+TEST_CASE("CheckedVector elementwise arithmetic")
+{
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> small(-1000, 1000);
+
+    std::vector<xxint::Wrapping<int16_t>> a_values, b_values;
+    CheckedVector<int16_t, xxint::policy::wrapping> a, b;
+    for (int i = 0; i < 700; ++i) {
+        int16_t x = int16_t(small(rng)), y = int16_t(small(rng));
+        if (i == 600) x = INT16_MAX;
+        a_values.push_back(x);
+        b_values.push_back(y);
+        a.push_back(x);
+        b.push_back(y);
+    }
+
+    // Repeated sums grow the bounds until the blocks are checked.
+    for (int round = 0; round < 20; ++round) {
+        a += b;
+        for (std::size_t i = 0; i < a_values.size(); ++i)
+            a_values[i] = a_values[i] + b_values[i];
+        check_values(a, a_values);
+    }
+
+    a -= b;
+    for (std::size_t i = 0; i < a_values.size(); ++i)
+        a_values[i] = a_values[i] - b_values[i];
+    check_values(a, a_values);
+    CHECK(a.any_overflowed());
+}
@@ -0,0 +1,186 @@
+#ifndef INT_PLUS_PLUS_ALLOC_H_
+#define INT_PLUS_PLUS_ALLOC_H_
+
+#include "xxint.hxx"
+
+#include <cstdint>
+#include <new>
+
+namespace xxint {
+
+/*
+ * ALLOCATION SIZES
+ */
+
+namespace detail {
+
+/// Is `n`, an integer or `Checked` integer, negative?
+template <class N>
+constexpr bool is_negative_size(N n)
+{
+    return is_too_small_for<std::size_t>(n);
+}
+
+template <class T, template <class> class P>
+constexpr bool is_negative_size(Checked<T, P> n)
+{
+    return is_too_small_for<std::size_t>(n.get());
+}
+
+/// Returns `size`.
+template <template <class> class P>
+constexpr std::size_t add_sizes(std::size_t size, std::size_t&)
+{
+    return size;
+}
+
+/// Adds `first` and `rest` to `size`, making `overflow` nonzero if the sum
+/// does not fit or a term is negative, rather than branching on each.
+template <template <class> class P, class First, class... Rest>
+constexpr std::size_t add_sizes(std::size_t size, std::size_t& overflow,
+                                First first, Rest... rest)
+{
+    bool carry = false;
+    size = add_carry(size, Checked<std::size_t, P>(first).get(), false,
+                     carry);
+    overflow |= std::size_t(carry) | std::size_t(is_negative_size(first));
+    return add_sizes<P>(size, overflow, rest...);
+}
+
+} // end detail
+
+/// The number of bytes in `n` objects of type `T` followed by `extra`
+/// bytes, such as a header, padding, or a trailing string: `n *
+/// sizeof(T) + extra...`, computed as one checked expression.
+///
+/// Each step records its overflow in a flag, and the flags are checked
+/// once at the end, so a size that does not fit in `std::size_t` is
+/// handled by policy `P` with a single branch. Under `policy::saturating`
+/// the result is then `SIZE_MAX`, which no allocator can satisfy, so that
+/// allocating it fails as any too-large request does, with no branch at
+/// all. A negative count or extra is handled by `P` as it converts to
+/// `std::size_t`, and then counts as an overflow, so that under saturation
+/// it too gives `SIZE_MAX` rather than a size that is too small.
+///
+/// ```cpp
+/// auto bytes = alloc_size<Entry>(count, sizeof(Header), name_length + 1);
+/// void* p = std::malloc(bytes.get());
+/// ```
+template <class T, template <class> class P = policy::throwing,
+          class N, class... Extra>
+constexpr Checked<std::size_t, P> alloc_size(N n, Extra... extra)
+{
+    static_assert(!P<std::size_t>::is_wrapping,
+                  "alloc_size: a wrapped size is never wanted");
+
+    // Nonzero on overflow: the high half of the product, or'd with the
+    // carries of the sum and the signs of the terms.
+    auto product = mul_wide(Checked<std::size_t, P>(n).get(), sizeof(T));
+    std::size_t overflow =
+            product.high | std::size_t(detail::is_negative_size(n));
+    std::size_t size = detail::add_sizes<P>(product.low, overflow, extra...);
+
+    return overflow != 0 ? P<std::size_t>::too_large("xxint::alloc_size")
+                         : size;
+}
+
+/*
+ * ARENAS
+ */
+
+/// A bump-pointer arena: a block of memory that hands out storage in order
+/// and frees it all at once, by `reset` or when the arena is destroyed.
+///
+/// Each allocation's size and alignment padding are computed by
+/// `alloc_size` with saturation, so that a request that overflows cannot
+/// wrap around to a small size; a single comparison with the space that
+/// remains then rejects both overflowed and oversized requests.
+///
+/// The arena does not construct or destroy objects; it returns
+/// uninitialized storage, as `std::allocator::allocate` does.
+class arena
+{
+public:
+    /// An arena of `capacity` bytes, allocated from the heap.
+    explicit arena(Checked<std::size_t> capacity)
+            : data_(static_cast<unsigned char*>(
+                      ::operator new(capacity.get())))
+            , capacity_(capacity.get())
+            , owned_(true)
+    { }
+
+    /// An arena over the `capacity` bytes at `buffer`, which must outlive
+    /// it.
+    arena(void* buffer, std::size_t capacity)
+            : data_(static_cast<unsigned char*>(buffer))
+            , capacity_(capacity)
+            , owned_(false)
+    { }
+
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+
+    ~arena()
+    {
+        if (owned_) ::operator delete(data_);
+    }
+
+    /// The size of the arena in bytes.
+    std::size_t capacity() const { return capacity_; }
+
+    /// The number of bytes allocated, including alignment padding.
+    std::size_t used() const { return offset_; }
+
+    /// The number of bytes not yet allocated.
+    std::size_t remaining() const { return capacity_ - offset_; }
+
+    /// Allocates uninitialized storage for `n` objects of type `T`, aligned
+    /// for `T`. Throws `std::bad_alloc` if it does not fit, and
+    /// `overflow_too_small` if `n` is negative.
+    template <class T>
+    T* allocate(Checked<std::size_t> n = 1)
+    {
+        std::size_t pad = pad_(alignof(T));
+        return static_cast<T*>(take_(pad,
+                alloc_size<T, policy::saturating>(n.get(), pad).get()));
+    }
+
+    /// Allocates `size` bytes aligned to `align`, which must be a power of
+    /// 2. Throws `std::bad_alloc` if they do not fit.
+    void* allocate(std::size_t size, std::size_t align)
+    {
+        std::size_t pad = pad_(align);
+        return take_(pad,
+                alloc_size<unsigned char, policy::saturating>(size, pad).get());
+    }
+
+    /// Frees everything allocated, for the arena to be used again.
+    void reset() { offset_ = 0; }
+
+private:
+    unsigned char* data_;
+    std::size_t capacity_;
+    std::size_t offset_ = 0;
+    bool owned_;
+
+    /// The padding before the next allocation to align it to `align`.
+    std::size_t pad_(std::size_t align) const
+    {
+        auto address = reinterpret_cast<std::uintptr_t>(data_ + offset_);
+        return std::size_t(-address & (align - 1));
+    }
+
+    /// Takes the next `padded` bytes, of which the first `pad` align the
+    /// rest, which are returned.
+    void* take_(std::size_t pad, std::size_t padded)
+    {
+        if (padded > capacity_ - offset_) throw std::bad_alloc();
+        void* result = data_ + offset_ + pad;
+        offset_ += padded;
+        return result;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,236 @@
+#ifndef INT_PLUS_PLUS_CURSOR_H_
+#define INT_PLUS_PLUS_CURSOR_H_
+
+#include "xxint.hxx"
+
+#include <stdexcept>
+
+namespace xxint {
+
+/// Thrown when a read would go past the end of a cursor's buffer.
+struct out_of_bounds : std::out_of_range
+{
+    using out_of_range::out_of_range;
+};
+
+/// The order of the bytes of an integer in a buffer.
+enum class byte_order
+{
+    little,
+    big,
+};
+
+/*
+ * CURSOR INTERNALS
+ */
+
+namespace detail {
+
+/// Reads a `T` stored at `p` in byte order `Order`.
+template <class T, byte_order Order>
+T load_ordered(const uint8_t* p)
+{
+    static_assert(int_traits<T>::width == 8 * sizeof(T),
+                  "xxint::byte_cursor: the value type has padding bits");
+
+    using U = make_unsigned_t<T>;
+    return static_cast<T>(Order == byte_order::little ? load_le<U>(p)
+                                                      : load_be<U>(p));
+}
+
+} // end detail
+
+/*
+ * RECORDS
+ */
+
+/// A span of bytes whose length has already been checked, from which
+/// fixed-width integers are read without further checks.
+///
+/// Records are made by `byte_cursor::record`, which checks that the whole
+/// record is in bounds once, so that reading its fields costs no more than
+/// reading through a raw pointer. Reading past its end is undefined.
+class byte_record
+{
+public:
+    /// The record `[first, last)`.
+    constexpr byte_record(const uint8_t* first, const uint8_t* last)
+            : ptr_(first), end_(last)
+    { }
+
+    /// The number of bytes not yet read.
+    constexpr std::size_t remaining() const
+    {
+        return std::size_t(end_ - ptr_);
+    }
+
+    /// The next byte to be read.
+    constexpr const uint8_t* ptr() const
+    {
+        return ptr_;
+    }
+
+    /// Reads a `T` in byte order `Order`, which must be in the record.
+    template <class T, byte_order Order = byte_order::little>
+    T read()
+    {
+        T value = detail::load_ordered<T, Order>(ptr_);
+        ptr_ += sizeof(T);
+        return value;
+    }
+
+    /// Skips `length` bytes, which must be in the record.
+    void skip(std::size_t length)
+    {
+        ptr_ += length;
+    }
+
+private:
+    const uint8_t* ptr_;
+    const uint8_t* end_;
+};
+
+/*
+ * CURSORS
+ */
+
+/// Reads fixed-width integers from an untrusted buffer, such as a network
+/// message or a file header, checking every read against the buffer's end.
+///
+/// Lengths are `Checked<std::size_t>`, so that a length computed from
+/// fields of the buffer, such as `count * 8 + 4`, or converted from a
+/// negative field, throws `overflow_too_large` or `overflow_too_small`
+/// rather than wrapping around to a small value that passes the bounds
+/// check. A length that is in range but goes past the end of the buffer
+/// throws `out_of_bounds`. Either way, the cursor does not move.
+///
+/// A fixed-layout run of fields is best read as a `byte_record`, whose
+/// length is checked once:
+///
+/// ```cpp
+/// byte_cursor in(message, size);
+/// auto count = in.read<uint32_t, byte_order::big>();
+/// auto items = in.record(byte_cursor::size_type(count) * 12);
+/// for (uint32_t i = 0; i < count; ++i) {
+///     auto id    = items.read<uint32_t, byte_order::big>();
+///     auto price = items.read<int64_t, byte_order::big>();
+/// }
+/// ```
+class byte_cursor
+{
+public:
+    /// The type of lengths and offsets.
+    using size_type = Checked<std::size_t>;
+
+    /// A cursor at the start of the `size` bytes at `data`.
+    constexpr byte_cursor(const uint8_t* data, std::size_t size)
+            : data_(data), size_(size), offset_(0)
+    { }
+
+    /// A cursor at the start of `[first, last)`.
+    constexpr byte_cursor(const uint8_t* first, const uint8_t* last)
+            : byte_cursor(first, std::size_t(last - first))
+    { }
+
+    /// The number of bytes read or skipped.
+    constexpr std::size_t offset() const
+    {
+        return offset_;
+    }
+
+    /// The size of the buffer.
+    constexpr std::size_t size() const
+    {
+        return size_;
+    }
+
+    /// The number of bytes not yet read.
+    constexpr std::size_t remaining() const
+    {
+        return size_ - offset_;
+    }
+
+    /// The next byte to be read.
+    constexpr const uint8_t* ptr() const
+    {
+        return data_ + offset_;
+    }
+
+    /// Are there at least `length` bytes left to read?
+    constexpr bool has(size_type length) const
+    {
+        return length.get() <= remaining();
+    }
+
+    /// Reads a `T` in byte order `Order`.
+    template <class T, byte_order Order = byte_order::little>
+    T read()
+    {
+        check_(sizeof(T));
+        T value = detail::load_ordered<T, Order>(ptr());
+        offset_ += sizeof(T);
+        return value;
+    }
+
+    /// Reads `count` `T`s in byte order `Order` into `out`, checking their
+    /// total length once.
+    template <class T, byte_order Order = byte_order::little>
+    void read(T* out, size_type count)
+    {
+        byte_record values = record(count * sizeof(T));
+        for (std::size_t i = 0; i < count.get(); ++i)
+            out[i] = values.read<T, Order>();
+    }
+
+    /// Skips `length` bytes.
+    void skip(size_type length)
+    {
+        check_(length.get());
+        offset_ += length.get();
+    }
+
+    /// Moves to `offset` bytes from the start of the buffer, which may be
+    /// its end.
+    void seek(size_type offset)
+    {
+        if (offset.get() > size_)
+            throw out_of_bounds("xxint::byte_cursor: seek past end");
+        offset_ = offset.get();
+    }
+
+    /// Checks that the next `length` bytes are in the buffer, and returns
+    /// them as a record to be read without further checks, skipping past
+    /// them.
+    byte_record record(size_type length)
+    {
+        check_(length.get());
+        const uint8_t* first = ptr();
+        offset_ += length.get();
+        return byte_record(first, ptr());
+    }
+
+    /// Returns the next `length` bytes as a cursor of their own, for a
+    /// nested structure of variable layout, skipping past them.
+    byte_cursor take(size_type length)
+    {
+        check_(length.get());
+        byte_cursor result(ptr(), length.get());
+        offset_ += length.get();
+        return result;
+    }
+
+private:
+    void check_(std::size_t length) const
+    {
+        if (length > remaining())
+            throw out_of_bounds("xxint::byte_cursor: read past end");
+    }
+
+    const uint8_t* data_;
+    std::size_t size_;
+    std::size_t offset_;
+};
+
+}
+
+#endif
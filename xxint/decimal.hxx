@@ -0,0 +1,417 @@
+#ifndef INT_PLUS_PLUS_DECIMAL_H_
+#define INT_PLUS_PLUS_DECIMAL_H_
+
+#include "xxint.hxx"
+
+namespace xxint {
+
+/*
+ * POWERS OF TEN AND ROUNDING
+ */
+
+namespace detail {
+
+/// Table of the powers of ten that fit in `T`, computed at compile time.
+template <class T>
+struct pow10_table
+{
+    static constexpr int size = max_pow10_exponent<T>() + 1;
+
+    T values[size];
+
+    constexpr pow10_table() : values()
+    {
+        T power = 1;
+        for (int i = 0; i < size; ++i) {
+            values[i] = power;
+            if (i + 1 < size) power *= 10;
+        }
+    }
+};
+
+/// Holds the `pow10_table` for `T`.
+template <class T>
+struct pow10_holder
+{
+    static constexpr pow10_table<T> table{};
+};
+
+template <class T>
+constexpr pow10_table<T> pow10_holder<T>::table;
+
+/// `10^exponent` as a `T`.
+///
+/// PRECONDITION: `0 <= exponent <= max_pow10_exponent<T>()`
+template <class T>
+constexpr T pow10(int exponent)
+{
+    return pow10_holder<T>::table.values[exponent];
+}
+
+/// Should a magnitude be incremented after dropping digits, given the
+/// first dropped digit, whether any later dropped digit was non-zero, and
+/// whether the last kept digit is odd?
+template <rounding R>
+constexpr bool round_up_magnitude(bool negative, unsigned first_dropped,
+                                  bool sticky, bool odd)
+{
+    bool inexact = first_dropped != 0 || sticky;
+
+    switch (R) {
+    case rounding::toward_zero:
+        return false;
+    case rounding::floor:
+        return negative && inexact;
+    case rounding::ceil:
+        return !negative && inexact;
+    case rounding::nearest:
+        return first_dropped >= 5;
+    case rounding::nearest_even:
+        return first_dropped > 5 || (first_dropped == 5 && (sticky || odd));
+    }
+
+    return false;
+}
+
+} // end detail
+
+/*
+ * DECIMAL NUMBERS
+ */
+
+/// A decimal number with a fixed number of fractional digits, stored as a
+/// `Checked<T, P>`.
+///
+/// The value represented is `raw() / 10^Scale`. For example, an amount of
+/// money in cents that throws rather than overflowing is
+///
+/// ```cpp
+/// using Money = Decimal<int64_t, 2>;
+/// Money price = Money::from_raw(1999);    // 19.99
+/// Money total = price * Money(3);         // 59.97
+/// ```
+///
+/// Addition and subtraction are exact. Multiplication and division compute
+/// exactly in a type twice as wide as `T` and round once; the operators use
+/// banker's rounding (`rounding::nearest_even`), and `mul` and `div` take
+/// the rounding mode as a template argument.
+template <class T,
+          int Scale,
+          template <class> class P = policy::throwing>
+class Decimal
+{
+    static_assert(0 <= Scale && Scale <= detail::max_pow10_exponent<T>(),
+                  "Decimal: 10^Scale must fit in T");
+
+public:
+    /// The representation type.
+    using repr_t = Checked<T, P>;
+
+    /// The number of fractional decimal digits.
+    static constexpr int scale = Scale;
+
+    /// Constructs zero.
+    constexpr Decimal() : raw_()
+    { }
+
+    /// Converts from an integer, according to policy `P` if it does not fit.
+    template <class U,
+              class = std::enable_if_t<std::is_integral<U>::value>>
+    constexpr Decimal(U value)
+            : raw_(repr_t(value) * repr_t(detail::pow10<T>(Scale)))
+    { }
+
+    /// Constructs from the raw representation, which is scaled by
+    /// `10^Scale`.
+    static constexpr Decimal from_raw(repr_t raw)
+    {
+        Decimal result;
+        result.raw_ = raw;
+        return result;
+    }
+
+    /// Gets the raw representation.
+    constexpr repr_t raw() const
+    {
+        return raw_;
+    }
+
+    /// Changes the scale, rounding according to `R` if digits are dropped
+    /// and checking according to policy `P` if digits are added.
+    template <int S, rounding R = rounding::nearest_even>
+    constexpr Decimal<T, S, P> rescale() const
+    {
+        constexpr int down = Scale > S ? Scale - S : 0;
+        constexpr int up   = S > Scale ? S - Scale : 0;
+
+        if (down > 0)
+            return Decimal<T, S, P>::from_raw(
+                    detail::div_round<R>(raw_.get(), detail::pow10<T>(down)));
+        else
+            return Decimal<T, S, P>::from_raw(
+                    raw_ * repr_t(detail::pow10<T>(up)));
+    }
+
+    /// Checked negation.
+    constexpr Decimal operator-() const
+    {
+        return from_raw(-raw_);
+    }
+
+    /// Checked addition.
+    constexpr Decimal operator+(Decimal other) const
+    {
+        return from_raw(raw_ + other.raw_);
+    }
+
+    /// Checked subtraction.
+    constexpr Decimal operator-(Decimal other) const
+    {
+        return from_raw(raw_ - other.raw_);
+    }
+
+    /// Multiplication, rounded according to `R`.
+    template <rounding R = rounding::nearest_even>
+    constexpr Decimal mul(Decimal other) const
+    {
+#if __has_builtin(__builtin_mul_overflow)
+        // When the unscaled product fits in T, avoid the (typically much
+        // slower) double-width division.
+        T product_t = 0;
+        if (!__builtin_mul_overflow(raw_.get(), other.raw_.get(), &product_t))
+            return from_raw(detail::div_round<R>(product_t, scale_()));
+#endif
+
+        wide_t product = wide_t(raw_.get()) * wide_t(other.raw_.get());
+        return from_raw(narrow_(detail::div_round<R>(product, wide_scale_())));
+    }
+
+    /// Division, rounded according to `R`.
+    template <rounding R = rounding::nearest_even>
+    constexpr Decimal div(Decimal other) const
+    {
+        if (other.raw_.get() == 0)
+            return from_raw(P<T>::div_zero("Decimal::div(Decimal)"));
+
+#if __has_builtin(__builtin_mul_overflow)
+        T dividend_t = 0;
+        if (!__builtin_mul_overflow(raw_.get(), scale_(), &dividend_t)
+                && !(dividend_t == detail::int_traits<T>::min()
+                     && other.raw_.get() == T(-1)))
+            return from_raw(detail::div_round<R>(dividend_t, other.raw_.get()));
+#endif
+
+        wide_t dividend = wide_t(raw_.get()) * wide_scale_();
+        wide_t divisor  = wide_t(other.raw_.get());
+        return from_raw(narrow_(detail::div_round<R>(dividend, divisor)));
+    }
+
+    /// Checked multiplication with banker's rounding.
+    constexpr Decimal operator*(Decimal other) const
+    {
+        return mul(other);
+    }
+
+    /// Checked division with banker's rounding.
+    constexpr Decimal operator/(Decimal other) const
+    {
+        return div(other);
+    }
+
+    /// Checked +=
+    constexpr Decimal& operator+=(Decimal other)
+    {
+        return *this = *this + other;
+    }
+
+    /// Checked -=
+    constexpr Decimal& operator-=(Decimal other)
+    {
+        return *this = *this - other;
+    }
+
+    /// Checked *=
+    constexpr Decimal& operator*=(Decimal other)
+    {
+        return *this = *this * other;
+    }
+
+    /// Checked /=
+    constexpr Decimal& operator/=(Decimal other)
+    {
+        return *this = *this / other;
+    }
+
+private:
+    using wide_t = detail::wider_t<T>;
+
+    repr_t raw_;
+
+    static constexpr T scale_()
+    {
+        return detail::pow10<T>(Scale);
+    }
+
+    static constexpr wide_t wide_scale_()
+    {
+        return wide_t(scale_());
+    }
+
+    static constexpr T narrow_(wide_t value)
+    {
+        return Convert<T, wide_t, P>::convert(value);
+    }
+};
+
+/// Equality for decimals of the same format.
+template <class T, int S, template <class> class P>
+constexpr bool operator==(Decimal<T, S, P> a, Decimal<T, S, P> b)
+{
+    return a.raw() == b.raw();
+}
+
+/// Inequality for decimals of the same format.
+template <class T, int S, template <class> class P>
+constexpr bool operator!=(Decimal<T, S, P> a, Decimal<T, S, P> b)
+{
+    return a.raw() != b.raw();
+}
+
+/// Less-than for decimals of the same format.
+template <class T, int S, template <class> class P>
+constexpr bool operator<(Decimal<T, S, P> a, Decimal<T, S, P> b)
+{
+    return a.raw() < b.raw();
+}
+
+/// Less-than-or-equal for decimals of the same format.
+template <class T, int S, template <class> class P>
+constexpr bool operator<=(Decimal<T, S, P> a, Decimal<T, S, P> b)
+{
+    return a.raw() <= b.raw();
+}
+
+/// Greater-than for decimals of the same format.
+template <class T, int S, template <class> class P>
+constexpr bool operator>(Decimal<T, S, P> a, Decimal<T, S, P> b)
+{
+    return a.raw() > b.raw();
+}
+
+/// Greater-than-or-equal for decimals of the same format.
+template <class T, int S, template <class> class P>
+constexpr bool operator>=(Decimal<T, S, P> a, Decimal<T, S, P> b)
+{
+    return a.raw() >= b.raw();
+}
+
+/// Formats `value` into `[first, last)` as an optional `-`, at least one
+/// integer digit, and, if `S > 0`, a `.` followed by exactly `S` digits.
+///
+/// On success returns the end of the written characters; if the buffer is
+/// too small, returns `{last, std::errc::value_too_large}`.
+template <class T, int S, template <class> class P>
+to_chars_result to_chars(char* first, char* last, Decimal<T, S, P> value)
+{
+    // Enough for the digits of any magnitude, plus a leading zero.
+    char buffer[detail::int_traits<T>::digits / 3 + 2];
+    char* end = buffer + sizeof buffer;
+    char* begin = end;
+
+    T raw = value.raw().get();
+    begin = detail::write_digits(detail::magnitude(raw), end);
+
+    while (end - begin < S + 1)
+        *--begin = '0';
+
+    std::ptrdiff_t needed = (end - begin) + (raw < 0) + (S > 0);
+    if (last - first < needed)
+        return {last, std::errc::value_too_large};
+
+    if (raw < 0) *first++ = '-';
+
+    for (char* split = end - S; begin < split; )
+        *first++ = *begin++;
+
+    if (S > 0) {
+        *first++ = '.';
+        while (begin < end)
+            *first++ = *begin++;
+    }
+
+    return {first, std::errc()};
+}
+
+/// Parses a decimal number from `[first, last)`: an optional `-`, digits,
+/// and optionally a `.` followed by digits, with at least one digit in all.
+///
+/// Fractional digits beyond `S` are rounded according to `R`. If the value
+/// does not fit in `T` it is handled by policy `P`: a throwing policy
+/// throws, and a saturating or wrapping policy stores the saturated or
+/// wrapped value. On a syntax error, returns `{first,
+/// std::errc::invalid_argument}` and leaves `value` unchanged.
+template <rounding R = rounding::nearest_even,
+          class T, int S, template <class> class P>
+from_chars_result from_chars(const char* first, const char* last,
+                             Decimal<T, S, P>& value)
+{
+    using U = detail::make_unsigned_t<T>;
+
+    const char* p = first;
+    bool negative = p != last && *p == '-';
+    if (negative) ++p;
+
+    detail::digit_accumulator<U> acc;
+    bool any_digits = false;
+
+    for (; p != last && unsigned(*p - '0') < 10; ++p) {
+        acc.push(unsigned(*p - '0'));
+        any_digits = true;
+    }
+
+    int frac_digits = 0;
+    unsigned first_dropped = 0;
+    bool sticky = false;
+
+    if (p != last && *p == '.' && p + 1 != last && unsigned(p[1] - '0') < 10) {
+        for (++p; p != last && unsigned(*p - '0') < 10; ++p) {
+            unsigned digit = unsigned(*p - '0');
+            if (frac_digits < S)
+                acc.push(digit);
+            else if (frac_digits == S)
+                first_dropped = digit;
+            else
+                sticky |= digit != 0;
+            ++frac_digits;
+        }
+        any_digits = true;
+    }
+
+    if (!any_digits)
+        return {first, std::errc::invalid_argument};
+
+    for (int i = frac_digits; i < S; ++i)
+        acc.push(0);
+
+    if (detail::round_up_magnitude<R>(negative, first_dropped, sticky,
+                                      (acc.value & 1) != 0))
+        acc.increment();
+
+    value = Decimal<T, S, P>::from_raw(detail::from_magnitude<T, P>(
+            negative, acc.value, acc.overflow, "xxint::from_chars(Decimal)"));
+
+    return {p, std::errc()};
+}
+
+/// Stream insertion for decimals.
+template <class T, int S, template <class> class P>
+std::ostream& operator<<(std::ostream& o, Decimal<T, S, P> a)
+{
+    char buffer[detail::int_traits<T>::digits / 3 + 4];
+    auto result = to_chars(buffer, buffer + sizeof buffer, a);
+    return o.write(buffer, result.ptr - buffer);
+}
+
+}
+
+#endif
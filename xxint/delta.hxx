@@ -0,0 +1,597 @@
+#ifndef INT_PLUS_PLUS_DELTA_H_
+#define INT_PLUS_PLUS_DELTA_H_
+
+#include "xxint.hxx"
+
+namespace xxint {
+
+/// How `pack_column` transforms each block of values before packing it.
+enum class delta_order
+{
+    /// The values themselves.
+    none = 0,
+    /// The differences of consecutive values, for counters and timestamps.
+    delta = 1,
+    /// The differences of consecutive differences, for values that change
+    /// at a nearly steady rate, such as timestamps at a fixed interval.
+    delta_of_delta = 2,
+};
+
+/*
+ * PACKING INTERNALS
+ */
+
+namespace detail {
+
+/// The number of lanes a block's residuals are interleaved in: residual
+/// `i` goes to lane `i % pack_lanes`, and each lane is packed into its own
+/// words, so that every lane shifts by the same amount at each step.
+constexpr std::size_t pack_lanes = 8;
+
+/// The size of a block's header before its first value.
+constexpr std::size_t block_header_bytes = 6;
+
+/// The value with the low `bits` bits set, for `0 <= bits <= width`.
+template <class U>
+constexpr U low_mask(int bits)
+{
+    return bits == int_traits<U>::width ? int_traits<U>::max()
+                                        : U(U(U(1) << bits) - 1);
+}
+
+/// The signed type as wide as `T`, in which differences are summed.
+template <class T>
+using difference_t = least_int_t<int_traits<T>::width, true>;
+
+/// The type of the residuals of a block of order `Order`: `T` itself for
+/// order 0, whose residuals are the values, and otherwise `T`'s
+/// difference type, since differences may be negative.
+template <class T, int Order>
+using residual_t = std::conditional_t<Order == 0, T, difference_t<T>>;
+
+/// The residual of `x[0]` for a block of order `Order`: the value itself,
+/// its difference from `x[-1]`, or the difference of those differences,
+/// computed with wrapping arithmetic.
+template <int Order, class T, template <class> class P>
+make_unsigned_t<T> residual(const Checked<T, P>* x)
+{
+    using W = Wrapping<T>;
+
+    W result = Order == 0 ? W(x[0].get())
+             : Order == 1 ? W(x[0].get()) - W(x[-1].get())
+             : W(x[0].get()) - W(x[-1].get()) - W(x[-1].get())
+                             + W(x[-2].get());
+    return static_cast<make_unsigned_t<T>>(result.get());
+}
+
+/// The number of bytes of a block of `n` values of order `order` whose
+/// residuals are packed in `bits` bits each.
+template <class U>
+constexpr std::size_t block_bytes(int order, std::size_t n, int bits)
+{
+    std::size_t groups = (n - std::size_t(order) + pack_lanes - 1)
+                         / pack_lanes;
+    std::size_t rows = (groups * std::size_t(bits)
+                        + std::size_t(int_traits<U>::width) - 1)
+                       / std::size_t(int_traits<U>::width);
+    return block_header_bytes + std::size_t(order + 1) * sizeof(U)
+           + rows * pack_lanes * sizeof(U);
+}
+
+/// Finds the least and greatest residuals `lo` and `hi` of `x[Order]`, ...,
+/// `x[n - 1]` for a block of order `Order`. Returns false if any difference
+/// taken does not fit in the difference type, in which case summing the
+/// differences would not give back the values.
+///
+/// A difference computed with wrapping is exact when its sign agrees with
+/// the comparison of its operands.
+template <int Order, class T, template <class> class P, class R>
+bool residual_range(const Checked<T, P>* x, std::size_t n, R& lo, R& hi)
+{
+    using S = difference_t<T>;
+
+    lo = int_traits<R>::max();
+    hi = int_traits<R>::min();
+    bool inexact = Order == 2
+            && (x[1].get() < x[0].get()) != (S(residual<1>(x + 1)) < 0);
+
+    // Eight at a time, so that each step can be done in vector registers.
+    auto step = [&](std::size_t i) {
+        R r = static_cast<R>(residual<Order>(x + i));
+        lo = r < lo ? r : lo;
+        hi = r > hi ? r : hi;
+        if (Order >= 1) {
+            S d = S(residual<1>(x + i));
+            inexact |= (x[i].get() < x[i - 1].get()) != (d < 0);
+            if (Order == 2) {
+                S before = S(residual<1>(x + i - 1));
+                inexact |= (d < before) != (S(r) < 0);
+            }
+        }
+    };
+
+    std::size_t i = std::size_t(Order);
+    for (; n - i >= pack_lanes; i += pack_lanes)
+        for (std::size_t j = 0; j < pack_lanes; ++j)
+            step(i + j);
+    for (; i < n; ++i)
+        step(i);
+
+    return !inexact;
+}
+
+/// Packs the offsets `residual - ref` of `x[Order]`, ..., `x[n - 1]`, of
+/// `bits` bits each, into lanes of little-endian words at `out`.
+template <int Order, class T, template <class> class P, class R>
+void pack_offsets(const Checked<T, P>* x, std::size_t n, R ref, int bits,
+                  uint8_t* out)
+{
+    using U = make_unsigned_t<T>;
+    constexpr int width = int_traits<U>::width;
+    constexpr std::size_t L = pack_lanes;
+
+    if (bits == 0) return;
+
+    U row[L] = {};
+    int used = 0;
+
+    for (std::size_t i = std::size_t(Order); i < n; i += L) {
+        U v[L];
+        if (n - i >= L) {
+            for (std::size_t j = 0; j < L; ++j)
+                v[j] = U(residual<Order>(x + i + j) - U(ref));
+        } else {
+            for (std::size_t j = 0; j < L; ++j)
+                v[j] = i + j < n ? U(residual<Order>(x + i + j) - U(ref))
+                                 : U(0);
+        }
+
+        for (std::size_t j = 0; j < L; ++j)
+            row[j] = U(row[j] | U(v[j] << used));
+
+        used += bits;
+        if (used >= width) {
+            for (std::size_t j = 0; j < L; ++j)
+                store_le(out + j * sizeof(U), row[j]);
+            out += L * sizeof(U);
+
+            // The high bits of `v` that did not fit start the next row.
+            used -= width;
+            for (std::size_t j = 0; j < L; ++j)
+                row[j] = used == 0 ? U(0) : U(v[j] >> (bits - used));
+        }
+    }
+
+    if (used > 0)
+        for (std::size_t j = 0; j < L; ++j)
+            store_le(out + j * sizeof(U), row[j]);
+}
+
+/// Unpacks the `count` offsets of `bits` bits each packed by `pack_offsets`
+/// at `p`, calling `f(v, i, k)` for each group of lanes with `v` holding
+/// the offsets of residuals `i`, ..., `i + k - 1`.
+template <class U, class F>
+void unpack_offsets(const uint8_t* p, std::size_t count, int bits, F f)
+{
+    constexpr int width = int_traits<U>::width;
+    constexpr std::size_t L = pack_lanes;
+
+    const U mask = low_mask<U>(bits);
+    U row[L] = {};
+    int used = 0;
+
+    if (bits > 0) {
+        for (std::size_t j = 0; j < L; ++j)
+            row[j] = load_le<U>(p + j * sizeof(U));
+        p += L * sizeof(U);
+    }
+
+    for (std::size_t i = 0; i < count; i += L) {
+        U v[L];
+        for (std::size_t j = 0; j < L; ++j)
+            v[j] = U(row[j] >> used);
+
+        used += bits;
+        if (used >= width) {
+            // The next row holds the rest of this group, if any, and the
+            // groups after it; past the last group there is no next row.
+            used -= width;
+            if (used > 0 || count - i > L) {
+                for (std::size_t j = 0; j < L; ++j)
+                    row[j] = load_le<U>(p + j * sizeof(U));
+                p += L * sizeof(U);
+            }
+            if (used > 0)
+                for (std::size_t j = 0; j < L; ++j)
+                    v[j] = U(v[j] | U(row[j] << (bits - used)));
+        }
+
+        for (std::size_t j = 0; j < L; ++j)
+            v[j] = U(v[j] & mask);
+
+        f(v, i, count - i < L ? count - i : L);
+    }
+}
+
+/// Adds `delta` to `value` if the sum fits in `V`; otherwise returns false.
+template <class V, class S>
+bool add_exact(V& value, S delta)
+{
+    using U = make_unsigned_t<V>;
+
+    U room = delta < 0 ? U(U(value) - U(int_traits<V>::min()))
+                       : U(U(int_traits<V>::max()) - U(value));
+    if (magnitude(delta) > room) return false;
+
+    value = static_cast<V>(U(U(value) + U(delta)));
+    return true;
+}
+
+/// Whether a block of `n` values of order `Order`, starting from `x0`, with
+/// first difference `d1`, whose residuals are at least `ref` and less than
+/// `ref + 2^bits`, can be summed without checking each sum.
+///
+/// Bounds the distance of every value from `x0` in saturating arithmetic,
+/// where a bound that saturates is simply too large.
+template <int Order, class T, class S, class R>
+bool sums_fit(T x0, S d1, R ref, int bits, std::size_t n)
+{
+    using U = make_unsigned_t<T>;
+    using Bound = Saturating<U>;
+
+    // The residuals themselves must fit.
+    U span = low_mask<U>(bits);
+    if (span > U(U(int_traits<R>::max()) - U(ref))) return false;
+    if (Order == 0) return true;
+
+    // Bounds on each residual, each difference, and each value's distance
+    // from `x0`.
+    Bound step = Bound(magnitude(ref)) + Bound(span);
+    if (Order == 2) {
+        step = Bound(magnitude(d1)) + Bound(n) * step;
+        if (step.get() > U(int_traits<S>::max())) return false;
+    }
+    U reach = (Bound(n) * step).get();
+
+    return reach < U(U(int_traits<T>::max()) - U(x0))
+        && reach < U(U(x0) - U(int_traits<T>::min()));
+}
+
+/// Sums the residuals of a block of order `Order` without checks, which
+/// `sums_fit` allows, or which wrapping policy `P` wants anyway.
+template <int Order, class T, template <class> class P, class R>
+void sum_residuals(const uint8_t* p, std::size_t n, int bits, T x0, R ref,
+                   difference_t<T> d1, Checked<T, P>* out)
+{
+    using U = make_unsigned_t<T>;
+
+    U x = U(x0), d = U(d1);
+    out += Order;
+
+    unpack_offsets<U>(p, n - Order, bits,
+                      [&](const U* v, std::size_t i, std::size_t k) {
+        for (std::size_t j = 0; j < k; ++j) {
+            U r = U(U(ref) + v[j]);
+            if (Order == 0) {
+                x = r;
+            } else if (Order == 1) {
+                x = U(x + r);
+            } else {
+                d = U(d + r);
+                x = U(x + d);
+            }
+            out[i + j] = Checked<T, P>(static_cast<T>(x));
+        }
+    });
+}
+
+/// Sums the residuals of a block of order `Order`, checking each sum and
+/// handling any that does not fit by policy `P`.
+template <int Order, class T, template <class> class P, class R>
+void sum_residuals_checked(const uint8_t* p, std::size_t n, int bits, T x0,
+                           R ref, difference_t<T> d1, Checked<T, P>* out)
+{
+    using U = make_unsigned_t<T>;
+    using S = difference_t<T>;
+
+    const char* who = "xxint::unpack_column";
+    const U room = U(U(int_traits<R>::max()) - U(ref));
+    T x = x0;
+    S d = d1;
+    out += Order;
+
+    unpack_offsets<U>(p, n - Order, bits,
+                      [&](const U* v, std::size_t i, std::size_t k) {
+        for (std::size_t j = 0; j < k; ++j) {
+            if (v[j] > room) {
+                x = P<T>::too_large(who);
+            } else {
+                R r = static_cast<R>(U(U(ref) + v[j]));
+                if (Order == 0) {
+                    x = static_cast<T>(r);
+                } else {
+                    S delta = S(r);
+                    bool fits = true;
+                    if (Order == 2) {
+                        // A difference that does not fit cannot have been
+                        // packed, so the value goes to the policy; `d` is
+                        // held at its limit so that later sums keep going
+                        // the same way.
+                        fits = add_exact(d, delta);
+                        if (!fits)
+                            d = delta < 0 ? int_traits<S>::min()
+                                          : int_traits<S>::max();
+                        delta = d;
+                    }
+                    if (!fits || !add_exact(x, delta))
+                        x = delta < 0 ? P<T>::too_small(who)
+                                      : P<T>::too_large(who);
+                }
+            }
+            out[i + j] = Checked<T, P>(x);
+        }
+    });
+}
+
+template <int Order, class T, template <class> class P, class R>
+void sum_block(const uint8_t* p, std::size_t n, int bits, T x0, R ref,
+               difference_t<T> d1, Checked<T, P>* out,
+               std::true_type /* is_wrapping */)
+{
+    sum_residuals<Order>(p, n, bits, x0, ref, d1, out);
+}
+
+template <int Order, class T, template <class> class P, class R>
+void sum_block(const uint8_t* p, std::size_t n, int bits, T x0, R ref,
+               difference_t<T> d1, Checked<T, P>* out,
+               std::false_type /* is_wrapping */)
+{
+    if (sums_fit<Order>(x0, d1, ref, bits, n))
+        sum_residuals<Order>(p, n, bits, x0, ref, d1, out);
+    else
+        sum_residuals_checked<Order>(p, n, bits, x0, ref, d1, out);
+}
+
+/// The second value of a block of order 2, `x0 + d1`, wrapped.
+template <template <class> class P, class T, class S>
+T second_value(T x0, S d1, std::true_type /* is_wrapping */)
+{
+    using U = make_unsigned_t<T>;
+    return static_cast<T>(U(U(x0) + U(d1)));
+}
+
+/// The second value of a block of order 2, `x0 + d1`, handled by policy
+/// `P` if it does not fit.
+template <template <class> class P, class T, class S>
+T second_value(T x0, S d1, std::false_type /* is_wrapping */)
+{
+    if (!add_exact(x0, d1))
+        x0 = d1 < 0 ? P<T>::too_small("xxint::unpack_column")
+                    : P<T>::too_large("xxint::unpack_column");
+    return x0;
+}
+
+/// Decodes a block of order `Order` and `n` values whose residuals are
+/// packed in `bits` bits, from its first value at `p`.
+template <int Order, class T, template <class> class P>
+void unpack_block(const uint8_t* p, std::size_t n, int bits,
+                  Checked<T, P>* out)
+{
+    using U = make_unsigned_t<T>;
+    using R = residual_t<T, Order>;
+    using S = difference_t<T>;
+
+    T x0 = T();
+    S d1 = S();
+    if (Order >= 1) {
+        x0 = static_cast<T>(load_le<U>(p));
+        out[0] = Checked<T, P>(x0);
+        p += sizeof(U);
+    }
+    if (Order == 2) {
+        d1 = static_cast<S>(load_le<U>(p));
+        x0 = second_value<P>(x0, d1,
+                std::integral_constant<bool, P<T>::is_wrapping>());
+        out[1] = Checked<T, P>(x0);
+        p += sizeof(U);
+    }
+    R ref = static_cast<R>(load_le<U>(p));
+    p += sizeof(U);
+
+    sum_block<Order>(p, n, bits, x0, ref, d1, out,
+                     std::integral_constant<bool, P<T>::is_wrapping>());
+}
+
+/// Encodes `x[0]`, ..., `x[n - 1]` as a block of order `Order` into
+/// `[first, last)`, storing the result in `result`. Returns false, writing
+/// nothing, if the block's differences do not fit in the difference type.
+template <int Order, class T, template <class> class P, class Result>
+bool pack_block(const Checked<T, P>* x, std::size_t n,
+                uint8_t* first, uint8_t* last, Result& result)
+{
+    using U = make_unsigned_t<T>;
+    using R = residual_t<T, Order>;
+
+    R lo, hi;
+    if (!residual_range<Order>(x, n, lo, hi)) return false;
+
+    int bits = bit_width(U(U(hi) - U(lo)));
+    std::size_t size = block_bytes<U>(Order, n, bits);
+    if (std::size_t(last - first) < size) {
+        result = {last, std::errc::value_too_large};
+        return true;
+    }
+
+    first[0] = uint8_t(Order);
+    first[1] = uint8_t(bits);
+    store_le(first + 2, uint32_t(n));
+
+    uint8_t* p = first + block_header_bytes;
+    if (Order >= 1) {
+        store_le(p, U(x[0].get()));
+        p += sizeof(U);
+    }
+    if (Order == 2) {
+        store_le(p, residual<1>(x + 1));
+        p += sizeof(U);
+    }
+    store_le(p, U(lo));
+    p += sizeof(U);
+
+    pack_offsets<Order>(x, n, lo, bits, p);
+
+    result = {first + size, std::errc()};
+    return true;
+}
+
+} // end detail
+
+/*
+ * PACKED COLUMNS
+ */
+
+/// Result of `pack_column`.
+struct pack_column_result
+{
+    uint8_t* ptr;
+    std::errc ec;
+};
+
+/// Result of `unpack_column`.
+struct unpack_column_result
+{
+    /// Where decoding stopped: `last`, the start of the first block that
+    /// did not fit in the output, or the start of a malformed block.
+    const uint8_t* ptr;
+
+    /// The number of values decoded.
+    std::size_t count;
+
+    /// `std::errc::invalid_argument` if decoding stopped at a malformed
+    /// block.
+    std::errc ec;
+};
+
+/// The most bytes that `pack_column` writes for `size` values of type `T`
+/// in blocks of `block_size`.
+template <class T>
+constexpr std::size_t max_packed_bytes(std::size_t size,
+                                       std::size_t block_size = 128)
+{
+    using U = detail::make_unsigned_t<T>;
+
+    std::size_t blocks = (size + block_size - 1) / block_size;
+    return blocks * (detail::block_header_bytes + 3 * sizeof(U))
+           + (size + blocks * detail::pack_lanes) * sizeof(U);
+}
+
+/// Encodes `values[0]`, ..., `values[size - 1]` into `[first, last)` in
+/// blocks of `block_size` values, for `unpack_column` to decode.
+///
+/// Each block stores its first `order` values or differences as they are,
+/// and then the rest of its residuals, which are the values, their
+/// differences, or the differences of those, as `delta_order` says. The
+/// residuals are computed with `Wrapping<T>` arithmetic. Each residual is
+/// stored as its offset from the block's least residual, in as many bits
+/// as the greatest offset needs: so the differences of a steady
+/// timestamp column, say, take a few bits each.
+///
+/// A block whose differences do not fit in the signed type of `T`'s width,
+/// which would wrap, uses the next lower order instead, so that decoding
+/// can check that the sums it takes fit.
+///
+/// Larger blocks cost less in headers, and smaller ones adapt better to
+/// changes in the values' spread. On success returns the end of the
+/// encoded column; if the buffer is too small, returns `{last,
+/// std::errc::value_too_large}`; if `block_size` is zero or does not fit
+/// in 32 bits, returns `{first, std::errc::invalid_argument}`.
+template <class T, template <class> class P>
+pack_column_result pack_column(uint8_t* first, uint8_t* last,
+                               const Checked<T, P>* values, std::size_t size,
+                               delta_order order,
+                               std::size_t block_size = 128)
+{
+    using U = detail::make_unsigned_t<T>;
+    static_assert(detail::int_traits<U>::width == CHAR_BIT * sizeof(U),
+                  "pack_column needs a type without padding bits");
+
+    if (block_size == 0 || block_size > UINT32_MAX)
+        return {first, std::errc::invalid_argument};
+
+    for (std::size_t i = 0; i < size; i += block_size) {
+        std::size_t n = size - i < block_size ? size - i : block_size;
+
+        // Every block has at least one residual.
+        int o = std::size_t(order) < n ? int(order) : int(n - 1);
+
+        pack_column_result result;
+        if (!(o >= 2 && detail::pack_block<2>(values + i, n, first, last,
+                                              result))
+                && !(o >= 1 && detail::pack_block<1>(values + i, n, first,
+                                                     last, result)))
+            detail::pack_block<0>(values + i, n, first, last, result);
+
+        if (result.ec != std::errc()) return result;
+        first = result.ptr;
+    }
+
+    return {first, std::errc()};
+}
+
+/// Decodes the blocks of a column encoded by `pack_column` from `[first,
+/// last)` into `out[0]`, `out[1]`, ..., up to `out[size - 1]`, stopping
+/// before a block that does not fit.
+///
+/// Sums that do not fit in `T`, which only a corrupted block produces, are
+/// handled by policy `P`: a throwing policy throws, and a saturating policy
+/// saturates, so that no value out of the range of the encoded type is
+/// produced. Each block is first checked as a whole, in saturating
+/// arithmetic, to see whether its residuals can add up to so much; if they
+/// cannot, which is the usual case, its values are summed without further
+/// checks. Under a wrapping policy, sums wrap as they did when encoding.
+///
+/// A block header that is out of range or promises more bytes than remain
+/// is malformed, and decoding stops there with
+/// `std::errc::invalid_argument`.
+template <class T, template <class> class P>
+unpack_column_result unpack_column(const uint8_t* first, const uint8_t* last,
+                                   Checked<T, P>* out, std::size_t size)
+{
+    using U = detail::make_unsigned_t<T>;
+    static_assert(detail::int_traits<U>::width == CHAR_BIT * sizeof(U),
+                  "unpack_column needs a type without padding bits");
+
+    std::size_t index = 0;
+
+    while (first != last) {
+        std::size_t available = std::size_t(last - first);
+        if (available < detail::block_header_bytes)
+            return {first, index, std::errc::invalid_argument};
+
+        int order = first[0];
+        int bits = first[1];
+        std::size_t n = detail::load_le<uint32_t>(first + 2);
+        if (order > 2 || bits > detail::int_traits<U>::width
+                || n <= std::size_t(order)
+                || available < detail::block_bytes<U>(order, n, bits))
+            return {first, index, std::errc::invalid_argument};
+
+        if (n > size - index) break;
+
+        const uint8_t* p = first + detail::block_header_bytes;
+        switch (order) {
+        case 0:  detail::unpack_block<0>(p, n, bits, out + index); break;
+        case 1:  detail::unpack_block<1>(p, n, bits, out + index); break;
+        default: detail::unpack_block<2>(p, n, bits, out + index); break;
+        }
+
+        first += detail::block_bytes<U>(order, n, bits);
+        index += n;
+    }
+
+    return {first, index, std::errc()};
+}
+
+}
+
+#endif
@@ -0,0 +1,259 @@
+#ifndef INT_PLUS_PLUS_FIELDS_H_
+#define INT_PLUS_PLUS_FIELDS_H_
+
+#include "decimal.hxx"
+
+#include <cstring>
+#include <vector>
+
+/// Defined if eight characters can be read as a little-endian 64-bit word.
+#ifdef XXINT_LITTLE_ENDIAN
+#  define XXINT_SWAR_DIGITS 1
+#endif
+
+namespace xxint {
+
+/*
+ * DIGITS EIGHT AT A TIME
+ */
+
+namespace detail {
+
+/// The next eight characters of `[p, last)` as a little-endian word, padded
+/// with zero bytes, which are not digits.
+inline uint64_t load_digit_word(const char* p, const char* last)
+{
+    uint64_t word = 0;
+    if (last - p >= 8)
+        std::memcpy(&word, p, 8);
+    else
+        std::memcpy(&word, p, std::size_t(last - p));
+    return word;
+}
+
+/// The high bit of each byte of `word` that is not an ASCII digit.
+///
+/// The byte's low seven bits are offset so that their sum carries into the
+/// high bit exactly when the byte is above `'9'`, or, for the second sum,
+/// at least `'0'`; neither sum carries into the next byte.
+constexpr uint64_t non_digit_bytes(uint64_t word)
+{
+    constexpr uint64_t high = 0x8080808080808080;
+
+    uint64_t low = word & ~high;
+    uint64_t above_nine = low + 0x4646464646464646;
+    uint64_t at_least_zero = low + 0x5050505050505050;
+    return (word | above_nine | ~at_least_zero) & high;
+}
+
+/// The value of the first `n` digits of `word`, where `1 <= n <= 8`.
+///
+/// Shifting the digits to the top of the word makes the bytes below them
+/// leading zeros, and then three multiplies combine neighbouring digits,
+/// then pairs, then quads.
+constexpr uint64_t combine_digits(uint64_t word, int n)
+{
+    word = (word - 0x3030303030303030) << (8 * (8 - n));
+    word = (word * 10 + (word >> 8)) & 0x00FF00FF00FF00FF;
+    word = (word * 100 + (word >> 16)) & 0x0000FFFF0000FFFF;
+    return (word * 10000 + (word >> 32)) & 0xFFFFFFFF;
+}
+
+/// Bit `i` is set where `block[i]` is `delimiter`, for each of the first
+/// 64 characters of `[block, last)`.
+///
+/// Each word is compared bytewise by exclusive-or; a byte is then zero
+/// exactly when its low seven bits plus 0x7F leave its high bit clear, and
+/// a multiply gathers the eight high bits into one byte.
+inline uint64_t delimiter_bits(const char* block, const char* last,
+                               char delimiter)
+{
+    constexpr uint64_t low = 0x7F7F7F7F7F7F7F7F;
+    const uint64_t repeated = 0x0101010101010101 * uint8_t(delimiter);
+
+    uint64_t result = 0;
+    for (int i = 0; i < 8 && 8 * i < last - block; ++i) {
+        uint64_t word = load_digit_word(block + 8 * i, last) ^ repeated;
+        uint64_t zero = ~(((word & low) + low) | word | low);
+        result |= (zero >> 7) * 0x0102040810204080 >> 56 << (8 * i);
+    }
+
+    if (last - block < 64)
+        result &= (uint64_t(1) << (last - block)) - 1;
+
+    return result;
+}
+
+/// Parses the field `[first, last)`, which may be followed by more
+/// characters up to `end`, into `value`. Returns false, leaving `value`
+/// unchanged, if the field is not an optional `-` followed by digits.
+template <class T, template <class> class P>
+bool parse_field(const char* first, const char* last, const char* end,
+                 Checked<T, P>& value)
+{
+    using U = make_unsigned_t<T>;
+
+    // Magnitudes go in a word or wider, so that for types of up to 64 bits
+    // overflow shows up only as a magnitude above `T`'s range.
+    using A = std::conditional_t<(int_traits<U>::width > 64), U, uint64_t>;
+
+    bool negative = first != last && *first == '-';
+    const char* digits = first + negative;
+    std::ptrdiff_t length = last - digits;
+    if (length == 0) return false;
+
+    A magnitude = 0;
+    bool overflow = false;
+
+#ifdef XXINT_SWAR_DIGITS
+    if (length <= max_pow10_exponent<A>()) {
+        // Up to eight digits at a time; the characters beyond the field
+        // are masked off.
+        for (const char* p = digits; p < last; p += 8) {
+            int n = last - p < 8 ? int(last - p) : 8;
+            uint64_t word = load_digit_word(p, end);
+            uint64_t mask = n == 8 ? ~uint64_t(0) : (uint64_t(1) << 8 * n) - 1;
+            if ((non_digit_bytes(word) & mask) != 0) return false;
+            magnitude = A(magnitude * pow10<uint64_t>(n)
+                          + combine_digits(word, n));
+        }
+    } else
+#endif
+    {
+        digit_accumulator<A> acc;
+        for (const char* p = digits; p != last; ++p) {
+            if (unsigned(*p - '0') >= 10) return false;
+            acc.push(unsigned(*p - '0'));
+        }
+        magnitude = acc.value;
+        overflow = acc.overflow;
+    }
+
+    // In range, negating without a branch, as the sign is unpredictable.
+    if (!overflow && magnitude <= A(int_traits<T>::max())
+            && (int_traits<T>::is_signed || !negative)) {
+        T result = T(magnitude);
+        value = Checked<T, P>(negative ? T(T(0) - result) : result);
+    } else {
+        value = Checked<T, P>(from_magnitude<T, P>(
+                negative, magnitude, overflow, "xxint::parse_fields"));
+    }
+
+    return true;
+}
+
+} // end detail
+
+/*
+ * DELIMITED FIELDS
+ */
+
+/// Result of `parse_fields`.
+struct parse_fields_result
+{
+    /// Where parsing stopped: `last`, or the start of the first field that
+    /// did not fit in the output.
+    const char* ptr;
+
+    /// The number of fields parsed, good and bad.
+    std::size_t count;
+};
+
+/// Parses the decimal integers in `[first, last)`, which are separated by
+/// `delimiter`, into `out[0]`, `out[1]`, ..., up to `out[size - 1]`.
+///
+/// Each field is an optional `-` followed by digits, as for `from_chars`,
+/// and a delimiter at the very end ends the last field rather than
+/// starting an empty one. So a file of one integer per line parses with
+/// `delimiter == '\n'`.
+///
+/// A field that does not fit in `T` is handled by policy `P`, exactly as
+/// `from_chars` would: a throwing policy throws, and a saturating or
+/// wrapping policy stores the saturated or wrapped value. Any other field
+/// is bad: its index is appended to `bad_fields` and its element of `out`
+/// is left unchanged.
+///
+/// Where bytes can be read as words, the delimiters are found 64
+/// characters at a time, and then each field's characters are classified
+/// and up to eight of its digits combined at a time, so a field of up to 8
+/// digits costs one word, and the overflow check happens once per field.
+template <class T, template <class> class P>
+parse_fields_result parse_fields(const char* first, const char* last,
+                                 char delimiter,
+                                 Checked<T, P>* out, std::size_t size,
+                                 std::vector<std::size_t>& bad_fields)
+{
+    const char* start = first;
+    std::size_t index = 0;
+
+    auto field = [&](const char* end) {
+        if (!detail::parse_field(start, end, last, out[index]))
+            bad_fields.push_back(index);
+        ++index;
+        start = end + 1;
+    };
+
+#ifdef XXINT_SWAR_DIGITS
+    // Where each field ends is known before it is parsed, so consecutive
+    // fields do not wait for each other.
+    for (std::ptrdiff_t offset = 0; offset < last - first && index < size;
+            offset += 64) {
+        const char* block = first + offset;
+        uint64_t bits = detail::delimiter_bits(block, last, delimiter);
+        for (; bits != 0 && index < size; bits &= bits - 1)
+            field(block + detail::countr_zero(bits));
+    }
+#else
+    while (index < size) {
+        auto end = static_cast<const char*>(
+                std::memchr(start, delimiter, std::size_t(last - start)));
+        if (end == nullptr) break;
+        field(end);
+    }
+#endif
+
+    if (start < last && index < size) {
+        field(last);
+        start = last;
+    }
+
+    return {start, index};
+}
+
+/// Result of `format_fields`.
+struct format_fields_result
+{
+    /// The end of the written characters.
+    char* ptr;
+
+    /// The number of values written.
+    std::size_t count;
+};
+
+/// Formats `values[0]`, ..., `values[size - 1]` into `[first, last)` as by
+/// `to_chars`, each followed by `delimiter`, so that `parse_fields` reads
+/// them back.
+///
+/// Stops before the first value that does not fit with its delimiter, so
+/// that the caller can flush the buffer and continue from `values + count`.
+template <class T, template <class> class P>
+format_fields_result format_fields(char* first, char* last,
+                                   const Checked<T, P>* values,
+                                   std::size_t size, char delimiter)
+{
+    std::size_t index = 0;
+
+    for (; index < size; ++index) {
+        auto result = to_chars(first, last, values[index]);
+        if (result.ec != std::errc() || result.ptr == last) break;
+
+        first = result.ptr;
+        *first++ = delimiter;
+    }
+
+    return {first, index};
+}
+
+}
+
+#endif
@@ -0,0 +1,244 @@
+#ifndef INT_PLUS_PLUS_FIXED_H_
+#define INT_PLUS_PLUS_FIXED_H_
+
+#include "xxint.hxx"
+
+#include <cmath>
+
+namespace xxint {
+
+/*
+ * FIXED-POINT NUMBERS
+ */
+
+/// A binary fixed-point number in Q format, stored as a `Checked<T, P>`.
+///
+/// The value represented is `raw() / 2^FracBits`. Addition and subtraction
+/// are those of the underlying `Checked<T, P>`. Multiplication and division
+/// compute exactly in a type twice as wide as `T`, round once according to
+/// a `rounding` mode, and then narrow back to `T` according to policy `P`.
+/// So a Q16.16 number that saturates instead of throwing is
+///
+/// ```cpp
+/// using Q16 = Fixed<int32_t, 16, policy::saturating>;
+/// Q16 x = Q16(3) / Q16(4);
+/// assert(x.raw() == 3 << 14);
+/// ```
+///
+/// For 64-bit `T`, multiplication and division require a 128-bit integer
+/// type (see `XXINT_HAS_INT128`).
+template <class T,
+          int FracBits,
+          template <class> class P = policy::throwing>
+class Fixed
+{
+    static_assert(0 <= FracBits && FracBits < detail::int_traits<T>::width,
+                  "Fixed: FracBits must be less than the width of T");
+
+public:
+    /// The representation type.
+    using repr_t = Checked<T, P>;
+
+    /// The number of fractional bits.
+    static constexpr int frac_bits = FracBits;
+
+    /// Constructs zero.
+    constexpr Fixed() : raw_()
+    { }
+
+    /// Converts from an integer, according to policy `P` if it does not fit.
+    template <class U,
+              class = std::enable_if_t<std::is_integral<U>::value>>
+    constexpr Fixed(U value) : raw_(repr_t(value) << FracBits)
+    { }
+
+    /// Constructs from the raw representation, which is scaled by
+    /// `2^FracBits`.
+    static constexpr Fixed from_raw(repr_t raw)
+    {
+        Fixed result;
+        result.raw_ = raw;
+        return result;
+    }
+
+    /// Gets the raw representation.
+    constexpr repr_t raw() const
+    {
+        return raw_;
+    }
+
+    /// Converts to an integer, rounding according to `R`.
+    template <rounding R = rounding::toward_zero>
+    constexpr repr_t to_int() const
+    {
+        return detail::shift_round<R>(raw_.get(), FracBits);
+    }
+
+    /// Converts to `double`, exactly if `T` has no more than 53 bits.
+    double to_double() const
+    {
+        return std::ldexp(static_cast<double>(raw_.get()), -FracBits);
+    }
+
+    /// Converts to another Q format, rounding according to `R` and checking
+    /// the result according to the old policy `P`.
+    template <class U,
+              int G,
+              template <class> class Q = P,
+              rounding R = rounding::nearest>
+    constexpr Fixed<U, G, Q> convert() const
+    {
+        return Fixed<U, G, Q>::from_raw(rescale_<U, G, R>(raw_.get()));
+    }
+
+    /// Checked negation.
+    constexpr Fixed operator-() const
+    {
+        return from_raw(-raw_);
+    }
+
+    /// Checked addition.
+    constexpr Fixed operator+(Fixed other) const
+    {
+        return from_raw(raw_ + other.raw_);
+    }
+
+    /// Checked subtraction.
+    constexpr Fixed operator-(Fixed other) const
+    {
+        return from_raw(raw_ - other.raw_);
+    }
+
+    /// Multiplication, computed exactly in double width and rounded
+    /// according to `R`.
+    template <rounding R = rounding::nearest>
+    constexpr Fixed mul(Fixed other) const
+    {
+        wide_t product = wide_t(raw_.get()) * wide_t(other.raw_.get());
+        return from_raw(narrow_(detail::shift_round<R>(product, FracBits)));
+    }
+
+    /// Division, computed exactly in double width and rounded according
+    /// to `R`.
+    template <rounding R = rounding::nearest>
+    constexpr Fixed div(Fixed other) const
+    {
+        if (other.raw_.get() == 0)
+            return from_raw(P<T>::div_zero("Fixed::div(Fixed)"));
+
+        wide_t dividend = wide_t(raw_.get()) * (wide_t(1) << FracBits);
+        wide_t divisor  = wide_t(other.raw_.get());
+        return from_raw(narrow_(detail::div_round<R>(dividend, divisor)));
+    }
+
+    /// Checked multiplication, rounding to nearest.
+    constexpr Fixed operator*(Fixed other) const
+    {
+        return mul(other);
+    }
+
+    /// Checked division, rounding to nearest.
+    constexpr Fixed operator/(Fixed other) const
+    {
+        return div(other);
+    }
+
+    /// Checked +=
+    constexpr Fixed& operator+=(Fixed other)
+    {
+        return *this = *this + other;
+    }
+
+    /// Checked -=
+    constexpr Fixed& operator-=(Fixed other)
+    {
+        return *this = *this - other;
+    }
+
+    /// Checked *=
+    constexpr Fixed& operator*=(Fixed other)
+    {
+        return *this = *this * other;
+    }
+
+    /// Checked /=
+    constexpr Fixed& operator/=(Fixed other)
+    {
+        return *this = *this / other;
+    }
+
+private:
+    using wide_t = detail::wider_t<T>;
+
+    repr_t raw_;
+
+    static constexpr T narrow_(wide_t value)
+    {
+        return Convert<T, wide_t, P>::convert(value);
+    }
+
+    template <class U, int G, rounding R>
+    static constexpr U rescale_(T raw)
+    {
+        // Both branches must compile, so the shift amounts are clamped.
+        if (G <= FracBits)
+            return Convert<U, T, P>::convert(
+                    detail::shift_round<R>(raw, G <= FracBits ? FracBits - G : 0));
+        else
+            return (Checked<U, P>(Convert<U, T, P>::convert(raw))
+                    << (G > FracBits ? G - FracBits : 0)).get();
+    }
+};
+
+/// Equality for fixed-point numbers of the same format.
+template <class T, int F, template <class> class P>
+constexpr bool operator==(Fixed<T, F, P> a, Fixed<T, F, P> b)
+{
+    return a.raw() == b.raw();
+}
+
+/// Inequality for fixed-point numbers of the same format.
+template <class T, int F, template <class> class P>
+constexpr bool operator!=(Fixed<T, F, P> a, Fixed<T, F, P> b)
+{
+    return a.raw() != b.raw();
+}
+
+/// Less-than for fixed-point numbers of the same format.
+template <class T, int F, template <class> class P>
+constexpr bool operator<(Fixed<T, F, P> a, Fixed<T, F, P> b)
+{
+    return a.raw() < b.raw();
+}
+
+/// Less-than-or-equal for fixed-point numbers of the same format.
+template <class T, int F, template <class> class P>
+constexpr bool operator<=(Fixed<T, F, P> a, Fixed<T, F, P> b)
+{
+    return a.raw() <= b.raw();
+}
+
+/// Greater-than for fixed-point numbers of the same format.
+template <class T, int F, template <class> class P>
+constexpr bool operator>(Fixed<T, F, P> a, Fixed<T, F, P> b)
+{
+    return a.raw() > b.raw();
+}
+
+/// Greater-than-or-equal for fixed-point numbers of the same format.
+template <class T, int F, template <class> class P>
+constexpr bool operator>=(Fixed<T, F, P> a, Fixed<T, F, P> b)
+{
+    return a.raw() >= b.raw();
+}
+
+/// Stream insertion for fixed-point numbers, via `to_double()`.
+template <class T, int F, template <class> class P>
+std::ostream& operator<<(std::ostream& o, Fixed<T, F, P> a)
+{
+    return o << a.to_double();
+}
+
+}
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef INT_PLUS_PLUS_GCD_H_
+#define INT_PLUS_PLUS_GCD_H_
+
+#include "xxint.hxx"
+
+#include <utility>
+
+namespace xxint {
+
+/*
+ * GCD ENGINES
+ */
+
+namespace detail {
+
+/// Stein's binary GCD, which replaces division by shifts and
+/// subtractions. Each step strips all trailing zeros at once, and the
+/// count of zeros to strip is taken from `a - b` before its sign is
+/// known, so the loop has no unpredictable branches.
+template <class U>
+constexpr U binary_gcd(U a, U b)
+{
+    if (a == 0) return b;
+    if (b == 0) return a;
+
+    int shift = countr_zero(U(a | b));
+    a = U(a >> countr_zero(a));
+    b = U(b >> countr_zero(b));
+
+    // Both are odd here, so every difference is even.
+    for (;;) {
+        U diff = U(a - b);
+        if (diff == 0) break;
+
+        int zeros = countr_zero(diff);
+        U low = a < b ? a : b;
+        a = a < b ? U(b - a) : diff;
+        b = low;
+        a = U(a >> zeros);
+    }
+
+    return U(a << shift);
+}
+
+/// GCD for words of at most 64 bits.
+template <class U>
+constexpr U gcd_unsigned(U a, U b, std::false_type /* wide */)
+{
+    return binary_gcd(a, b);
+}
+
+/// Lehmer's GCD for types wider than 64 bits (Knuth, TAOCP 4.5.2,
+/// Algorithm L).
+///
+/// Each outer step runs Euclid's algorithm on the leading 62 bits of `a`
+/// and `b` in single-word arithmetic for as long as the quotients are
+/// certain to match the full-width ones, and then applies the accumulated
+/// cofactors to the full-width values in one step. Once `b` fits in a
+/// word, the rest is a single-word binary GCD.
+template <class U>
+constexpr U gcd_unsigned(U a, U b, std::true_type /* wide */)
+{
+    if (a < b) {
+        U t = a;
+        a = b;
+        b = t;
+    }
+
+    constexpr int digit = 62;
+
+    while (bit_width(b) > 64) {
+        int shift = bit_width(a) - digit;
+        auto x = static_cast<int64_t>(a >> shift);
+        auto y = static_cast<int64_t>(b >> shift);
+
+        int64_t A = 1, B = 0, C = 0, D = 1;
+
+        // Knuth's test takes floors; keeping every operand non-negative
+        // makes C++'s truncating division agree.
+        while (y + C > 0 && y + D > 0 && x + A >= 0 && x + B >= 0) {
+            int64_t q = (x + A) / (y + C);
+            if (q != (x + B) / (y + D)) break;
+
+            int64_t t = A - q * C; A = C; C = t;
+            t = B - q * D; B = D; D = t;
+            t = x - q * y; x = y; y = t;
+        }
+
+        if (B == 0) {
+            U r = a % b;
+            a = b;
+            b = r;
+        } else {
+            // The cofactors have alternating signs and the results are
+            // exact remainders, so arithmetic modulo 2^w is exact.
+            U na = U(U(A) * a + U(B) * b);
+            U nb = U(U(C) * a + U(D) * b);
+            a = na;
+            b = nb;
+        }
+    }
+
+    if (b == 0) return a;
+
+    auto small = static_cast<uint64_t>(b);
+    if (bit_width(a) > 64) a = a % small;
+    return binary_gcd(static_cast<uint64_t>(a), small);
+}
+
+/// The greatest common divisor of unsigned `a` and `b`.
+template <class U>
+constexpr U gcd_unsigned(U a, U b)
+{
+    return gcd_unsigned(a, b, std::integral_constant<bool,
+                                (int_traits<U>::width > 64)>());
+}
+
+} // end detail
+
+/*
+ * GCD AND LCM
+ */
+
+/// The greatest common divisor of the magnitudes of `a` and `b`, as an
+/// unsigned type so that it cannot overflow. `gcd(0, 0)` is 0.
+template <class T>
+constexpr auto gcd(T a, T b)
+{
+    return detail::gcd_unsigned(detail::magnitude(a), detail::magnitude(b));
+}
+
+/// The greatest common divisor of two checked integers, non-negative.
+///
+/// The only result that can fail to fit is `2^(w-1)`, from `gcd(MIN, 0)`
+/// or `gcd(MIN, MIN)` for signed `T`; that is too large according to `P`.
+template <class T, template <class> class P>
+constexpr Checked<T, P> gcd(Checked<T, P> a, Checked<T, P> b)
+{
+    return Checked<detail::make_unsigned_t<T>, P>(gcd(a.get(), b.get()))
+        .template convert<T, P>();
+}
+
+/// The least common multiple of two checked integers, non-negative.
+/// `lcm(a, 0)` is 0. Overflow is handled according to `P`.
+template <class T, template <class> class P>
+constexpr Checked<T, P> lcm(Checked<T, P> a, Checked<T, P> b)
+{
+    using U = detail::make_unsigned_t<T>;
+
+    if (a == 0 || b == 0) return Checked<T, P>(0);
+
+    U g = gcd(a.get(), b.get());
+    Checked<U, P> product = Checked<U, P>(U(detail::magnitude(a.get()) / g))
+                          * Checked<U, P>(detail::magnitude(b.get()));
+    return product.template convert<T, P>();
+}
+
+}
+
+#endif
@@ -0,0 +1,293 @@
+#ifndef INT_PLUS_PLUS_MAPPED_H_
+#define INT_PLUS_PLUS_MAPPED_H_
+
+#include "xxint.hxx"
+
+#include <cerrno>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+/// Defined when files can be memory-mapped, in which case `mapped_column`
+/// is provided.
+#  define XXINT_HAS_MMAP 1
+#endif
+
+namespace xxint {
+
+/*
+ * BULK CONVERSION
+ */
+
+namespace detail {
+
+/// The number of values `convert_values` range-checks at once: enough to
+/// amortize the check, few enough that the values are still in cache if
+/// they must be converted again.
+constexpr std::size_t convert_chunk_size = 512;
+
+/// The number of values converted per row within a chunk.
+constexpr std::size_t convert_lanes = 8;
+
+/// Converts `in[0]`, ..., `in[size - 1]` into `out` without checks, and
+/// returns whether they all fit in `To`: a value fits if it survives the
+/// round trip through `To`, and, when only one of the types is signed, if
+/// its top bit is clear. The differences are or-ed rather than compared,
+/// so that the loop vectorizes with plain bitwise instructions.
+template <class To, template <class> class P, class From>
+bool convert_unchecked(const From* in, std::size_t size, Checked<To, P>* out)
+{
+    using V = make_unsigned_t<From>;
+
+    constexpr bool mixed =
+            int_traits<To>::is_signed != int_traits<From>::is_signed;
+    constexpr V top = mixed ? V(V(1) << (int_traits<V>::width - 1)) : V(0);
+
+    auto convert = [&](std::size_t i) {
+        To to = static_cast<To>(in[i]);
+        out[i] = Checked<To, P>(to);
+        return V((static_cast<V>(in[i]) ^ static_cast<V>(From(to)))
+                 | (static_cast<V>(in[i]) & top));
+    };
+
+    // Rows of a fixed number of values, which compilers vectorize more
+    // readily than a loop of unknown length.
+    V bad = 0;
+    std::size_t i = 0;
+    for (; size - i >= convert_lanes; i += convert_lanes) {
+        for (std::size_t j = 0; j < convert_lanes; ++j)
+            bad = V(bad | convert(i + j));
+    }
+    for (; i < size; ++i)
+        bad = V(bad | convert(i));
+
+    return bad == 0;
+}
+
+/// Converts `in[0]`, ..., `in[size - 1]` into `out`. A chunk whose values
+/// all fit in `To` is converted once, without checks; otherwise it is
+/// converted again, each value through `Convert`.
+template <class To, template <class> class P, class From>
+void convert_chunk(const From* in, std::size_t size, Checked<To, P>* out,
+                   std::false_type /* is_as_wide_as */)
+{
+    if (!convert_unchecked(in, size, out)) {
+        for (std::size_t i = 0; i < size; ++i)
+            out[i] = Checked<To, P>(Convert<To, From, P>::convert(in[i]));
+    }
+}
+
+/// Widens `in[0]`, ..., `in[size - 1]` into `out`.
+template <class To, template <class> class P, class From>
+void convert_chunk(const From* in, std::size_t size, Checked<To, P>* out,
+                   std::true_type /* is_as_wide_as */)
+{
+    for (std::size_t i = 0; i < size; ++i)
+        out[i] = Checked<To, P>(static_cast<To>(in[i]));
+}
+
+template <class To, template <class> class P, class From>
+void convert_chunk(const From* in, std::size_t size, Checked<To, P>* out)
+{
+    convert_chunk(in, size, out,
+                  std::integral_constant<bool,
+                          is_as_wide_as<To, From>()
+                          || P<To>::is_wrapping>());
+}
+
+} // end detail
+
+/// Converts `in[0]`, ..., `in[size - 1]` into `out[0]`, ..., `out[size - 1]`
+/// as by `Convert<To, From, P>`, so that values that do not fit are handled
+/// by policy `P`.
+///
+/// The values are range-checked a chunk at a time rather than one at a
+/// time, so that a chunk whose values all fit, as most do in practice, is
+/// converted by a single loop the compiler can vectorize. A chunk with a
+/// value that does not fit is converted again, value by value.
+template <class To, template <class> class P, class From>
+void convert_values(const From* in, std::size_t size, Checked<To, P>* out)
+{
+    for (std::size_t done = 0; done < size; ) {
+        std::size_t n = size - done < detail::convert_chunk_size
+                        ? size - done : detail::convert_chunk_size;
+        detail::convert_chunk(in + done, n, out + done);
+        done += n;
+    }
+}
+
+#ifdef XXINT_HAS_MMAP
+
+/*
+ * MAPPED COLUMNS
+ */
+
+/// A read-only memory mapping of a file of little-endian `T`s, as written
+/// by a column store, which converts them to narrower `Checked` types
+/// without first copying the file to the heap.
+///
+/// The mapping is the view: the values are read in place, and pages of the
+/// file are brought in by the kernel as they are first touched. Where
+/// memory is little-endian, `data()`, `begin()`, and `end()` give the
+/// values directly.
+template <class T = int64_t>
+class mapped_column
+{
+    static_assert(detail::int_traits<T>::width == 8 * sizeof(T),
+                  "mapped_column: the value type has padding bits");
+
+    using U = detail::make_unsigned_t<T>;
+
+public:
+    /// The type of the values in the file.
+    using value_type = T;
+
+    /// Maps the file at `path`, which must hold a whole number of `T`s.
+    ///
+    /// Throws `std::system_error` if the file cannot be opened or mapped,
+    /// or if it is not a regular file whose size is a multiple of
+    /// `sizeof(T)`.
+    explicit mapped_column(const char* path)
+    {
+        int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) fail_(errno, path);
+
+        struct stat st;
+        int error = ::fstat(fd, &st) != 0 ? errno
+                  : !S_ISREG(st.st_mode) ? EINVAL
+                  : uintmax_t(st.st_size) > SIZE_MAX ? EFBIG
+                  : std::size_t(st.st_size) % sizeof(T) != 0 ? EINVAL
+                  : 0;
+
+        std::size_t bytes = error == 0 ? std::size_t(st.st_size) : 0;
+
+        // An empty file cannot be mapped, and need not be.
+        if (bytes != 0) {
+            void* p = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                error = errno;
+            } else {
+                ::madvise(p, bytes, MADV_SEQUENTIAL);
+                bytes_ = static_cast<const uint8_t*>(p);
+                size_  = bytes / sizeof(T);
+            }
+        }
+
+        ::close(fd);
+        if (error != 0) fail_(error, path);
+    }
+
+    /// Maps the file at `path`.
+    explicit mapped_column(const std::string& path)
+            : mapped_column(path.c_str())
+    { }
+
+    mapped_column(const mapped_column&) = delete;
+    mapped_column& operator=(const mapped_column&) = delete;
+
+    /// Takes over `other`'s mapping, leaving it empty.
+    mapped_column(mapped_column&& other) noexcept
+            : bytes_(other.bytes_), size_(other.size_)
+    {
+        other.bytes_ = nullptr;
+        other.size_  = 0;
+    }
+
+    /// Unmaps this column and takes over `other`'s mapping, leaving it
+    /// empty.
+    mapped_column& operator=(mapped_column&& other) noexcept
+    {
+        if (this != &other) {
+            unmap_();
+            bytes_ = std::exchange(other.bytes_, nullptr);
+            size_  = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    ~mapped_column()
+    {
+        unmap_();
+    }
+
+    /// The number of values.
+    std::size_t size() const { return size_; }
+
+    /// Is the file empty?
+    bool empty() const { return size_ == 0; }
+
+    /// The file's bytes.
+    const uint8_t* bytes() const { return bytes_; }
+
+    /// The value at `index`, which must be less than `size()`.
+    T operator[](std::size_t index) const
+    {
+        return static_cast<T>(
+                detail::load_le<U>(bytes_ + index * sizeof(T)));
+    }
+
+#ifdef XXINT_LITTLE_ENDIAN
+    /// The values, in place.
+    const T* data() const { return reinterpret_cast<const T*>(bytes_); }
+    const T* begin() const { return data(); }
+    const T* end() const { return data() + size_; }
+#endif
+
+    /// Converts up to `count` values, starting at `first`, into `out` as by
+    /// `convert_values`, so that values that do not fit in `To` are handled
+    /// by policy `P`. Returns the number converted, which is less than
+    /// `count` only at the end of the column.
+    ///
+    /// Reading a large column into a buffer of a few thousand values at a
+    /// time keeps both the buffer and the mapped pages being read in cache.
+    template <class To, template <class> class P>
+    std::size_t read(std::size_t first, Checked<To, P>* out,
+                     std::size_t count) const
+    {
+        if (first >= size_) return 0;
+        if (count > size_ - first) count = size_ - first;
+
+#ifdef XXINT_LITTLE_ENDIAN
+        convert_values(data() + first, count, out);
+#else
+        T chunk[detail::convert_chunk_size];
+        for (std::size_t done = 0; done < count; ) {
+            std::size_t n = count - done < detail::convert_chunk_size
+                            ? count - done : detail::convert_chunk_size;
+            for (std::size_t i = 0; i < n; ++i)
+                chunk[i] = (*this)[first + done + i];
+            detail::convert_chunk(chunk, n, out + done);
+            done += n;
+        }
+#endif
+
+        return count;
+    }
+
+private:
+    void unmap_()
+    {
+        if (bytes_ != nullptr)
+            ::munmap(const_cast<uint8_t*>(bytes_), size_ * sizeof(T));
+    }
+
+    [[noreturn]] static void fail_(int error, const char* path)
+    {
+        throw std::system_error(error, std::generic_category(),
+                                std::string("xxint::mapped_column: ") + path);
+    }
+
+    const uint8_t* bytes_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+#endif // XXINT_HAS_MMAP
+
+}
+
+#endif
@@ -0,0 +1,517 @@
+#ifndef INT_PLUS_PLUS_MODULAR_H_
+#define INT_PLUS_PLUS_MODULAR_H_
+
+#include "xxint.hxx"
+
+namespace xxint {
+
+/*
+ * MODULAR ARITHMETIC
+ */
+
+/// An odd or even modulus `m >= 2` together with the constants needed to
+/// reduce products modulo `m` without a hardware division.
+///
+/// Odd moduli use Montgomery multiplication, so residues are kept in
+/// Montgomery form (`a * 2^w mod m`, where `w` is the width of `T`); even
+/// moduli use Barrett reduction on residues in ordinary form. The
+/// representation of residues is therefore private to a `Modulus`: create
+/// them with `from_integer` or `from_residue` and read them back with
+/// `get`. Most code should use `Modular` or `DynamicModular` instead.
+///
+/// `T` must be unsigned. Products are formed in `detail::wider_t<T>`, so a
+/// 64-bit `T` requires `XXINT_HAS_INT128`.
+template <class T>
+class Modulus
+{
+    static_assert(!detail::int_traits<T>::is_signed,
+                  "Modulus: T must be unsigned");
+
+    using wide_t = detail::wider_t<T>;
+
+public:
+    /// Precomputes the reduction constants for `m`. Throws
+    /// `overflow_too_small` if `m < 2`.
+    constexpr explicit Modulus(T m)
+            : m_(m < 2 ? policy::throwing<T>::too_small("xxint::Modulus") : m)
+            , odd_((m & 1) != 0)
+            , inv_(odd_ ? inverse_mod_r_(m) : T(0))
+            , r2_(odd_ ? r_squared_(m) : T(0))
+            , mu_(odd_ ? wide_t(0) : wide_t(detail::int_traits<wide_t>::max() / m))
+            , one_(odd_ ? T(r_mod_m_(m)) : T(1))
+    { }
+
+    /// The modulus.
+    constexpr T get() const
+    {
+        return m_;
+    }
+
+    /// The residue of any integer `x`.
+    template <class U>
+    constexpr T from_integer(U x) const
+    {
+        auto canonical = T(detail::magnitude(x) % m_);
+        if (x < 0 && canonical != 0)
+            canonical = m_ - canonical;
+        return to_repr_(canonical);
+    }
+
+    /// The residue of `r`, which must already be reduced. Throws
+    /// `overflow_too_large` if `r >= m`.
+    constexpr T from_residue(T r) const
+    {
+        if (r >= m_)
+            policy::throwing<T>::too_large("xxint::Modulus::from_residue");
+        return to_repr_(r);
+    }
+
+    /// The canonical value of residue `a`, in `[0, m)`.
+    constexpr T get(T a) const
+    {
+        return odd_ ? redc_(a) : a;
+    }
+
+    /// The residue representing 1.
+    constexpr T one() const
+    {
+        return one_;
+    }
+
+    /// Modular addition of residues.
+    constexpr T add(T a, T b) const
+    {
+        T sum = T(a + b);
+        return sum >= m_ || sum < a ? T(sum - m_) : sum;
+    }
+
+    /// Modular subtraction of residues.
+    constexpr T sub(T a, T b) const
+    {
+        return a >= b ? T(a - b) : T(a - b + m_);
+    }
+
+    /// Modular negation of a residue.
+    constexpr T neg(T a) const
+    {
+        return a == 0 ? a : T(m_ - a);
+    }
+
+    /// Modular multiplication of residues.
+    constexpr T mul(T a, T b) const
+    {
+        wide_t product = detail::mul_low<wide_t>(a, b);
+        return odd_ ? redc_(product) : barrett_(product);
+    }
+
+    /// Raises residue `a` to the power `e` by repeated squaring. A negative
+    /// exponent raises the inverse of `a`.
+    template <class E>
+    constexpr T pow(T a, E e) const
+    {
+        auto bits = detail::magnitude(e);
+        if (e < 0) a = inverse(a);
+
+        T result = one_;
+        while (bits != 0) {
+            if (bits & 1) result = mul(result, a);
+            a = mul(a, a);
+            bits >>= 1;
+        }
+
+        return result;
+    }
+
+    /// The multiplicative inverse of residue `a`. Throws
+    /// `overflow_div_zero` if `a` is not coprime to the modulus.
+    constexpr T inverse(T a) const
+    {
+        using S = detail::least_int_t<detail::int_traits<wide_t>::width, true>;
+
+        // Extended Euclid on canonical values; the coefficients are bounded
+        // by `m` in magnitude, so they fit in the signed double-width type.
+        S t0 = 0, t1 = 1;
+        T r0 = m_, r1 = get(a);
+
+        while (r1 != 0) {
+            T q = r0 / r1;
+            T r2 = T(r0 - q * r1);
+            r0 = r1; r1 = r2;
+            S t2 = t0 - S(q) * t1;
+            t0 = t1; t1 = t2;
+        }
+
+        if (r0 != 1)
+            return policy::throwing<T>::div_zero("Modulus::inverse(T)");
+
+        return to_repr_(T(t0 < 0 ? t0 + S(m_) : t0));
+    }
+
+private:
+    T m_;
+    bool odd_;
+    T inv_;         // m^-1 mod 2^w, if odd
+    T r2_;          // 2^2w mod m, if odd
+    wide_t mu_;     // floor((2^2w - 1) / m), if even
+    T one_;         // the residue of 1
+
+    static constexpr T inverse_mod_r_(T m)
+    {
+        // Newton's iteration; m * m == 1 mod 8 for odd m, so `inv` starts
+        // correct to 3 bits and each step doubles that.
+        T inv = m;
+        for (int bits = 3; bits < detail::int_traits<T>::width; bits *= 2)
+            inv = detail::mul_low<T>(inv, T(2 - detail::mul_low<T>(m, inv)));
+        return inv;
+    }
+
+    static constexpr T r_mod_m_(T m)
+    {
+        return T(T(T(0) - m) % m);
+    }
+
+    static constexpr T r_squared_(T m)
+    {
+        T r = r_mod_m_(m);
+        return T(detail::mul_low<wide_t>(r, r) % m);
+    }
+
+    constexpr T to_repr_(T canonical) const
+    {
+        return odd_ ? redc_(detail::mul_low<wide_t>(canonical, r2_))
+                    : canonical;
+    }
+
+    // Montgomery reduction: x * 2^-w mod m, for x < m * 2^w.
+    constexpr T redc_(wide_t x) const
+    {
+        T lo = T(x);
+        T hi = T(x >> detail::int_traits<T>::width);
+        // The low halves of x and q * m agree, so only the high halves
+        // need subtracting.
+        T q  = detail::mul_low<T>(lo, inv_);
+        T qm = detail::mul_high<T>(q, m_);
+        return hi >= qm ? T(hi - qm) : T(hi - qm + m_);
+    }
+
+    // Barrett reduction: x mod m, for x < 2^2w. The quotient estimate is
+    // at most one too small.
+    constexpr T barrett_(wide_t x) const
+    {
+        wide_t q = detail::mul_high<wide_t>(x, mu_);
+        wide_t r = wide_t(x - detail::mul_low<wide_t>(q, m_));
+        return T(r >= m_ ? r - m_ : r);
+    }
+};
+
+/// Integers modulo a compile-time modulus `M`, stored as an unsigned `T`.
+///
+/// Arithmetic never overflows: every operation reduces modulo `M`, by
+/// Montgomery multiplication when `M` is odd and by Barrett reduction when
+/// it is even, so no hardware division is needed. For example,
+///
+/// ```cpp
+/// using Z = Modular<uint32_t, 1000000007>;
+/// Z x = Z(2).pow(100);
+/// assert(x * x.inverse() == Z(1));
+/// ```
+template <class T, T M>
+class Modular
+{
+public:
+    /// Constructs zero.
+    constexpr Modular() : repr_(0)
+    { }
+
+    /// Converts from any integer, reducing modulo `M`. Negative values map
+    /// to their mathematical residue, so `Modular(-1) == Modular(M - 1)`.
+    template <class U,
+              class = std::enable_if_t<std::is_integral<U>::value>>
+    constexpr Modular(U value) : repr_(modulus_.from_integer(value))
+    { }
+
+    /// Converts from any checked integer, reducing modulo `M`.
+    template <class U, template <class> class P>
+    constexpr Modular(Checked<U, P> value) : Modular(value.get())
+    { }
+
+    /// Constructs from a value already in `[0, M)`. Throws
+    /// `overflow_too_large` otherwise.
+    static constexpr Modular from_residue(T value)
+    {
+        return from_repr_(modulus_.from_residue(value));
+    }
+
+    /// The modulus.
+    static constexpr T modulus()
+    {
+        return M;
+    }
+
+    /// The canonical value, in `[0, M)`.
+    constexpr T get() const
+    {
+        return modulus_.get(repr_);
+    }
+
+    /// Modular negation.
+    constexpr Modular operator-() const
+    {
+        return from_repr_(modulus_.neg(repr_));
+    }
+
+    /// Modular addition.
+    constexpr Modular operator+(Modular other) const
+    {
+        return from_repr_(modulus_.add(repr_, other.repr_));
+    }
+
+    /// Modular subtraction.
+    constexpr Modular operator-(Modular other) const
+    {
+        return from_repr_(modulus_.sub(repr_, other.repr_));
+    }
+
+    /// Modular multiplication.
+    constexpr Modular operator*(Modular other) const
+    {
+        return from_repr_(modulus_.mul(repr_, other.repr_));
+    }
+
+    /// Modular division. Throws `overflow_div_zero` if `other` is not
+    /// invertible.
+    constexpr Modular operator/(Modular other) const
+    {
+        return *this * other.inverse();
+    }
+
+    /// Modular exponentiation.
+    template <class E>
+    constexpr Modular pow(E exponent) const
+    {
+        return from_repr_(modulus_.pow(repr_, exponent));
+    }
+
+    /// Multiplicative inverse. Throws `overflow_div_zero` if the value is not
+    /// coprime to `M`.
+    constexpr Modular inverse() const
+    {
+        return from_repr_(modulus_.inverse(repr_));
+    }
+
+    /// Modular +=
+    constexpr Modular& operator+=(Modular other)
+    {
+        return *this = *this + other;
+    }
+
+    /// Modular -=
+    constexpr Modular& operator-=(Modular other)
+    {
+        return *this = *this - other;
+    }
+
+    /// Modular *=
+    constexpr Modular& operator*=(Modular other)
+    {
+        return *this = *this * other;
+    }
+
+    /// Modular /=
+    constexpr Modular& operator/=(Modular other)
+    {
+        return *this = *this / other;
+    }
+
+    /// Equality.
+    friend constexpr bool operator==(Modular a, Modular b)
+    {
+        return a.repr_ == b.repr_;
+    }
+
+    /// Inequality.
+    friend constexpr bool operator!=(Modular a, Modular b)
+    {
+        return a.repr_ != b.repr_;
+    }
+
+private:
+    static constexpr Modulus<T> modulus_{M};
+
+    T repr_;
+
+    static constexpr Modular from_repr_(T repr)
+    {
+        Modular result;
+        result.repr_ = repr;
+        return result;
+    }
+};
+
+template <class T, T M>
+constexpr Modulus<T> Modular<T, M>::modulus_;
+
+/// Integers modulo a modulus chosen at run time.
+///
+/// Each value refers to a `Modulus`, which must outlive it; operations on
+/// values with different moduli throw `std::invalid_argument`.
+///
+/// ```cpp
+/// Modulus<uint64_t> m(p);
+/// DynamicModular<uint64_t> x(m, 2);
+/// auto y = x.pow(p - 1);      // == DynamicModular<uint64_t>(m, 1)
+/// ```
+template <class T>
+class DynamicModular
+{
+public:
+    /// Converts from any integer, reducing modulo `m.get()`.
+    template <class U,
+              class = std::enable_if_t<std::is_integral<U>::value>>
+    constexpr DynamicModular(const Modulus<T>& m, U value)
+            : modulus_(&m), repr_(m.from_integer(value))
+    { }
+
+    /// Converts from any checked integer, reducing modulo `m.get()`.
+    template <class U, template <class> class P>
+    constexpr DynamicModular(const Modulus<T>& m, Checked<U, P> value)
+            : DynamicModular(m, value.get())
+    { }
+
+    /// Constructs from a value already in `[0, m.get())`. Throws
+    /// `overflow_too_large` otherwise.
+    static constexpr DynamicModular from_residue(const Modulus<T>& m, T value)
+    {
+        return DynamicModular(&m, m.from_residue(value));
+    }
+
+    /// The modulus.
+    constexpr const Modulus<T>& modulus() const
+    {
+        return *modulus_;
+    }
+
+    /// The canonical value, in `[0, modulus().get())`.
+    constexpr T get() const
+    {
+        return modulus_->get(repr_);
+    }
+
+    /// Modular negation.
+    constexpr DynamicModular operator-() const
+    {
+        return DynamicModular(modulus_, modulus_->neg(repr_));
+    }
+
+    /// Modular addition.
+    constexpr DynamicModular operator+(DynamicModular other) const
+    {
+        return DynamicModular(modulus_,
+                              same_(other).add(repr_, other.repr_));
+    }
+
+    /// Modular subtraction.
+    constexpr DynamicModular operator-(DynamicModular other) const
+    {
+        return DynamicModular(modulus_,
+                              same_(other).sub(repr_, other.repr_));
+    }
+
+    /// Modular multiplication.
+    constexpr DynamicModular operator*(DynamicModular other) const
+    {
+        return DynamicModular(modulus_,
+                              same_(other).mul(repr_, other.repr_));
+    }
+
+    /// Modular division. Throws `overflow_div_zero` if `other` is not
+    /// invertible.
+    constexpr DynamicModular operator/(DynamicModular other) const
+    {
+        return *this * other.inverse();
+    }
+
+    /// Modular exponentiation.
+    template <class E>
+    constexpr DynamicModular pow(E exponent) const
+    {
+        return DynamicModular(modulus_, modulus_->pow(repr_, exponent));
+    }
+
+    /// Multiplicative inverse. Throws `overflow_div_zero` if the value is
+    /// not coprime to the modulus.
+    constexpr DynamicModular inverse() const
+    {
+        return DynamicModular(modulus_, modulus_->inverse(repr_));
+    }
+
+    /// Modular +=
+    constexpr DynamicModular& operator+=(DynamicModular other)
+    {
+        return *this = *this + other;
+    }
+
+    /// Modular -=
+    constexpr DynamicModular& operator-=(DynamicModular other)
+    {
+        return *this = *this - other;
+    }
+
+    /// Modular *=
+    constexpr DynamicModular& operator*=(DynamicModular other)
+    {
+        return *this = *this * other;
+    }
+
+    /// Modular /=
+    constexpr DynamicModular& operator/=(DynamicModular other)
+    {
+        return *this = *this / other;
+    }
+
+    /// Equality; values with different moduli are unequal.
+    friend constexpr bool operator==(DynamicModular a, DynamicModular b)
+    {
+        return a.modulus_->get() == b.modulus_->get() && a.get() == b.get();
+    }
+
+    /// Inequality.
+    friend constexpr bool operator!=(DynamicModular a, DynamicModular b)
+    {
+        return !(a == b);
+    }
+
+private:
+    const Modulus<T>* modulus_;
+    T repr_;
+
+    constexpr DynamicModular(const Modulus<T>* m, T repr)
+            : modulus_(m), repr_(repr)
+    { }
+
+    constexpr const Modulus<T>& same_(DynamicModular other) const
+    {
+        if (modulus_ != other.modulus_
+                && modulus_->get() != other.modulus_->get())
+            throw std::invalid_argument("DynamicModular: different moduli");
+        return *modulus_;
+    }
+};
+
+/// Stream insertion for modular integers.
+template <class T, T M>
+std::ostream& operator<<(std::ostream& o, Modular<T, M> a)
+{
+    return o << detail::streamable(a.get());
+}
+
+/// Stream insertion for run-time modular integers.
+template <class T>
+std::ostream& operator<<(std::ostream& o, DynamicModular<T> a)
+{
+    return o << detail::streamable(a.get());
+}
+
+}
+
+#endif
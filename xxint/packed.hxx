@@ -0,0 +1,289 @@
+#ifndef INT_PLUS_PLUS_PACKED_H_
+#define INT_PLUS_PLUS_PACKED_H_
+
+#include "xxint.hxx"
+
+#include <vector>
+
+namespace xxint {
+
+/*
+ * N-BIT CONVERSIONS
+ */
+
+namespace detail {
+
+/// The least value of a `Bits`-bit integer of `T`'s signedness.
+template <class T, int Bits>
+constexpr T bits_min()
+{
+    return int_traits<T>::is_signed
+        ? static_cast<T>(-static_cast<int64_t>(uint64_t(1) << (Bits - 1)))
+        : T(0);
+}
+
+/// The greatest value of a `Bits`-bit integer of `T`'s signedness.
+template <class T, int Bits>
+constexpr T bits_max()
+{
+    return static_cast<T>(
+            (uint64_t(1) << (Bits - int_traits<T>::is_signed)) - 1);
+}
+
+/// The low `Bits` bits of `word` as a `T`, sign-extended if `T` is signed.
+template <class T, int Bits>
+constexpr T from_bits(uint64_t word)
+{
+    using U = make_unsigned_t<T>;
+    constexpr uint64_t mask = ~uint64_t(0) >> (64 - Bits);
+    constexpr U sign = int_traits<T>::is_signed ? U(U(1) << (Bits - 1)) : U(0);
+
+    U bits = U(word & mask);
+    return static_cast<T>(U(U(bits ^ sign) - sign));
+}
+
+/// Narrows `value` to `Bits` bits by wrapping.
+template <class T, int Bits, template <class> class P>
+constexpr T narrow_bits(T value, std::true_type /* is_wrapping */)
+{
+    return from_bits<T, Bits>(uint64_t(make_unsigned_t<T>(value)));
+}
+
+/// Narrows `value` to `Bits` bits, handling values out of range by policy
+/// `P`. The policy's result is clamped to the `Bits`-bit range, so that
+/// saturation saturates at it.
+template <class T, int Bits, template <class> class P>
+constexpr T narrow_bits(T value, std::false_type /* is_wrapping */)
+{
+    constexpr T lo = bits_min<T, Bits>();
+    constexpr T hi = bits_max<T, Bits>();
+
+    T result = value < lo ? P<T>::too_small("PackedArray")
+             : value > hi ? P<T>::too_large("PackedArray")
+             : value;
+    return result < lo ? lo : result > hi ? hi : result;
+}
+
+/// Converts `from` to a `Bits`-bit integer of type `T` as `Convert` would
+/// convert it to a built-in type of that width: through `T` by
+/// `Convert<T, From, P>`, then to `Bits` bits by policy `P`.
+template <class T, int Bits, template <class> class P, class From>
+constexpr T convert_bits(From from)
+{
+    return narrow_bits<T, Bits, P>(Convert<T, From, P>::convert(from),
+                                   std::integral_constant<bool,
+                                           P<T>::is_wrapping>());
+}
+
+/// The raw value of `value`.
+template <class T>
+constexpr T raw_value(T value)
+{
+    return value;
+}
+
+template <class T, template <class> class P>
+constexpr T raw_value(Checked<T, P> value)
+{
+    return value.get();
+}
+
+} // end detail
+
+/*
+ * PACKED ARRAYS
+ */
+
+/// A fixed-size array of `Bits`-bit integers of `T`'s signedness, stored
+/// contiguously with no bits between them, and read as `Checked<T, P>`.
+///
+/// Storing a value converts it to `Bits` bits just as `Convert` converts to
+/// a built-in type: a value out of the `Bits`-bit range throws, saturates
+/// at that range, or wraps, according to `P`. So a `PackedArray<int16_t,
+/// 12>` holds 12-bit values in a quarter less memory than an array of
+/// `int16_t`, and `PackedArray<uint32_t, 9>` in a quarter of the memory of
+/// an array of `uint32_t`.
+///
+/// Each value is read or written with one unaligned 64-bit load, which is
+/// why `Bits` is at most 32 and the storage has a word of slack at the end.
+/// `unpack` and `pack` work in groups of eight values, which fill exactly
+/// `Bits` bytes, so that their shifts are constants.
+template <class T, int Bits, template <class> class P = policy::throwing>
+class PackedArray
+{
+    static_assert(Bits >= 1 && Bits <= 32 && Bits <= detail::int_traits<T>::width,
+                  "PackedArray: Bits must be from 1 to 32, and fit in T");
+
+public:
+    /// The type of the values.
+    using value_type = Checked<T, P>;
+
+    /// The number of bits in each value.
+    static constexpr int bits = Bits;
+
+    /// The least value that can be stored.
+    static constexpr T min() { return detail::bits_min<T, Bits>(); }
+
+    /// The greatest value that can be stored.
+    static constexpr T max() { return detail::bits_max<T, Bits>(); }
+
+    /// An array of `size` zeros.
+    explicit PackedArray(std::size_t size = 0)
+            : size_(size)
+            , bytes_(((Checked<std::size_t>(size) * Bits + 7) / 8 + 8).get())
+    { }
+
+    /// The number of values.
+    std::size_t size() const { return size_; }
+
+    /// The packed values, which take `(size() * Bits + 7) / 8` bytes.
+    const uint8_t* bytes() const { return bytes_.data(); }
+
+    /// The value at `index`.
+    value_type operator[](std::size_t index) const
+    {
+        std::size_t bit = index * Bits;
+        uint64_t word = detail::load_le<uint64_t>(&bytes_[bit / 8]);
+        return value_type(detail::from_bits<T, Bits>(word >> bit % 8));
+    }
+
+    /// Sets the value at `index` to `value`, an integer or `Checked`
+    /// integer, converted to `Bits` bits according to policy `P`.
+    template <class U>
+    void set(std::size_t index, U value)
+    {
+        store_(index, detail::convert_bits<T, Bits, P>(
+                detail::raw_value(value)));
+    }
+
+    /// Copies `count` values, starting at `first`, to `out`.
+    void unpack(std::size_t first, value_type* out, std::size_t count) const
+    {
+        std::size_t last = first + count;
+        for (; first < last && first % 8 != 0; ++first)
+            *out++ = (*this)[first];
+
+        for (; last - first >= 8; first += 8, out += 8)
+            unpack_group_(&bytes_[first / 8 * Bits], out,
+                          std::integral_constant<int, 0>());
+
+        for (; first < last; ++first)
+            *out++ = (*this)[first];
+    }
+
+    /// Sets `count` values, starting at `first`, from `in`, integers or
+    /// `Checked` integers, as by `set`. A group of eight values that all
+    /// fit in `Bits` bits is written without further checks.
+    template <class U>
+    void pack(std::size_t first, const U* in, std::size_t count)
+    {
+        using W = detail::make_unsigned_t<T>;
+
+        std::size_t last = first + count;
+        for (; first < last && first % 8 != 0; ++first)
+            set(first, *in++);
+
+        for (; last - first >= 8; first += 8, in += 8) {
+            T group[8];
+            bool bad = false;
+            for (int j = 0; j < 8; ++j) {
+                group[j] = Convert<T, decltype(detail::raw_value(in[j])), P>
+                        ::convert(detail::raw_value(in[j]));
+                bad |= W(W(group[j]) - W(min())) > W(W(max()) - W(min()));
+            }
+
+            if (bad) {
+                for (int j = 0; j < 8; ++j)
+                    group[j] = detail::narrow_bits<T, Bits, P>(group[j],
+                            std::integral_constant<bool,
+                                    P<T>::is_wrapping>());
+            }
+
+            write_group_(&bytes_[first / 8 * Bits], group);
+        }
+
+        for (; first < last; ++first)
+            set(first, *in++);
+    }
+
+private:
+    std::size_t size_;
+    std::vector<uint8_t> bytes_;
+
+    static constexpr uint64_t mask_ = ~uint64_t(0) >> (64 - Bits);
+
+    /// Stores `value`, which fits, at `index`.
+    void store_(std::size_t index, T value)
+    {
+        std::size_t bit = index * Bits;
+        uint8_t* p = &bytes_[bit / 8];
+        int shift = int(bit % 8);
+
+        uint64_t word = detail::load_le<uint64_t>(p);
+        word &= ~(mask_ << shift);
+        word |= (uint64_t(detail::make_unsigned_t<T>(value)) & mask_) << shift;
+        detail::store_le(p, word);
+    }
+
+    /// Reads values `J` to 7 of the group of eight at `group` into `out`.
+    /// Each is a separate instantiation, so that its offset and shift are
+    /// constants.
+    template <int J>
+    static void unpack_group_(const uint8_t* group, value_type* out,
+                              std::integral_constant<int, J>)
+    {
+        uint64_t word = detail::load_le<uint64_t>(group + J * Bits / 8);
+        out[J] = value_type(detail::from_bits<T, Bits>(word >> J * Bits % 8));
+        unpack_group_(group, out, std::integral_constant<int, J + 1>());
+    }
+
+    static void unpack_group_(const uint8_t*, value_type*,
+                              std::integral_constant<int, 8>)
+    { }
+
+    /// Or's the bits of values `J` to 7 of `group` into `words`.
+    template <int J>
+    static void pack_group_(uint64_t* words, const T* group,
+                            std::integral_constant<int, J>)
+    {
+        constexpr int bit = J * Bits;
+        uint64_t bits = uint64_t(detail::make_unsigned_t<T>(group[J])) & mask_;
+        words[bit / 64] |= bits << bit % 64;
+        if (bit % 64 + Bits > 64)
+            words[bit / 64 + 1] |= bits >> (64 - bit % 64) % 64;
+        pack_group_(words, group, std::integral_constant<int, J + 1>());
+    }
+
+    static void pack_group_(uint64_t*, const T*,
+                            std::integral_constant<int, 8>)
+    { }
+
+    /// Writes the eight values of `group`, which fit, to the `Bits` bytes
+    /// at `p`, a word at a time. The bytes after them in the last word,
+    /// which may belong to the next group or to the slack, are kept.
+    static void write_group_(uint8_t* p, const T* group)
+    {
+        uint64_t words[Bits / 8 + 1] = {};
+        pack_group_(words, group, std::integral_constant<int, 0>());
+
+        for (int k = 0; k < Bits / 8; ++k)
+            detail::store_le(p + 8 * k, words[k]);
+
+        if (Bits % 8 != 0) {
+            uint8_t* q = p + Bits / 8 * 8;
+            uint64_t kept = ~uint64_t(0) << Bits % 8 * 8;
+            detail::store_le(q, (detail::load_le<uint64_t>(q) & kept)
+                                | words[Bits / 8]);
+        }
+    }
+};
+
+template <class T, int Bits, template <class> class P>
+constexpr int PackedArray<T, Bits, P>::bits;
+
+template <class T, int Bits, template <class> class P>
+constexpr uint64_t PackedArray<T, Bits, P>::mask_;
+
+}
+
+#endif
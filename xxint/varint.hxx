@@ -0,0 +1,363 @@
+#ifndef INT_PLUS_PLUS_VARINT_H_
+#define INT_PLUS_PLUS_VARINT_H_
+
+#include "xxint.hxx"
+
+#include <cstring>
+
+/// Defined if eight bytes can be read as a little-endian 64-bit word.
+#ifdef XXINT_LITTLE_ENDIAN
+#  define XXINT_SWAR_VARINTS 1
+#endif
+
+namespace xxint {
+
+/*
+ * ZIGZAG ENCODING
+ */
+
+/// Maps signed `value` to an unsigned value so that small magnitudes stay
+/// small: 0, -1, 1, -2, 2, ... become 0, 1, 2, 3, 4, ....
+template <class T>
+constexpr detail::make_unsigned_t<T> zigzag_encode(T value)
+{
+    using U = detail::make_unsigned_t<T>;
+    constexpr int width = detail::int_traits<U>::width;
+
+    // The sign bit, shifted down and negated, is all ones exactly when
+    // `value` is negative.
+    U bits = static_cast<U>(value);
+    return U(U(bits << 1) ^ U(U(0) - U(bits >> (width - 1))));
+}
+
+/// Inverts `zigzag_encode`, giving the signed `T` that encodes to `value`.
+template <class T>
+constexpr T zigzag_decode(detail::make_unsigned_t<T> value)
+{
+    using U = detail::make_unsigned_t<T>;
+    return static_cast<T>(U(U(value >> 1) ^ U(U(0) - U(value & 1))));
+}
+
+/*
+ * VARINT INTERNALS
+ */
+
+namespace detail {
+
+/// The unsigned type in which varints for `T` are decoded: a word, or `T`'s
+/// own unsigned type if that is wider.
+template <class T>
+using varint_wire_t = std::conditional_t<(int_traits<T>::width > 64),
+                                         make_unsigned_t<T>, uint64_t>;
+
+/// The type of a decoded varint for `T` before it is converted to `T`: the
+/// wire type, or for signed `T`, the signed type of the same width.
+template <class T>
+using varint_value_t = std::conditional_t<
+        !int_traits<T>::is_signed, varint_wire_t<T>,
+        std::conditional_t<(int_traits<T>::width > 64), T, int64_t>>;
+
+/// The value that encodes `value` as a varint: itself if unsigned, or
+/// zigzag-encoded if signed.
+template <class T>
+constexpr make_unsigned_t<T> to_varint(T value)
+{
+    return int_traits<T>::is_signed ? zigzag_encode(value)
+                                    : static_cast<make_unsigned_t<T>>(value);
+}
+
+/// Converts a decoded varint to `T` according to policy `P`, undoing zigzag
+/// encoding for signed `T`. If `overflow`, the varint's value did not fit
+/// in `A`, and `wire` holds only its low bits.
+template <class T, template <class> class P, class A>
+constexpr T from_varint(A wire, bool overflow)
+{
+    using V = varint_value_t<T>;
+
+    // The sign is the low bit, which survives overflow.
+    if (overflow && !P<T>::is_wrapping)
+        return from_magnitude<T, P>(int_traits<T>::is_signed && (wire & 1),
+                                    A(0), true, "xxint::decode_varint");
+
+    V value = int_traits<T>::is_signed ? zigzag_decode<V>(wire)
+                                       : static_cast<V>(wire);
+    return Convert<T, V, P>::convert(value);
+}
+
+/// Converts a one-byte varint, which fits in any `T` with at least seven
+/// value bits.
+template <class T>
+constexpr T from_small_varint(unsigned byte)
+{
+    return int_traits<T>::is_signed
+        ? static_cast<T>(T(byte >> 1) ^ T(T(0) - T(byte & 1)))
+        : static_cast<T>(byte);
+}
+
+/// The number of bytes in the varint of a value that has `bits` bits.
+constexpr int varint_length(int bits)
+{
+    return (bits + 6) / 7 + (bits == 0);
+}
+
+/// Reads the varint at `first`, stopping at `last`, into `value`. Returns
+/// the end of the varint, or `nullptr` if it is not terminated before
+/// `last`. Sets `overflow` if the varint's value does not fit in `A`, in
+/// which case `value` holds its low bits.
+///
+/// Groups of zero bits beyond `A`'s width are padding, not overflow, as
+/// LEB128 allows.
+template <class A>
+const uint8_t* read_varint(const uint8_t* first, const uint8_t* last,
+                           A& value, bool& overflow)
+{
+    constexpr int width = int_traits<A>::width;
+
+    value = 0;
+    overflow = false;
+
+    for (int shift = 0; first != last; ) {
+        A group = A(*first & 0x7F);
+
+        if (shift < width) {
+            if (shift > width - 7 && (group >> (width - shift)) != 0)
+                overflow = true;
+            value = A(value | A(group << shift));
+            shift += 7;
+        } else if (group != 0) {
+            overflow = true;
+        }
+
+        if (*first++ < 0x80) return first;
+    }
+
+    return nullptr;
+}
+
+/// Gathers the low seven bits of each byte of `word` into the low 56 bits,
+/// first byte lowest: neighbouring bytes, then pairs, then quads.
+constexpr uint64_t gather_varint_groups(uint64_t word)
+{
+    word = ((word & 0x7F007F007F007F00) >> 1) | (word & 0x007F007F007F007F);
+    word = ((word & 0x3FFF00003FFF0000) >> 2) | (word & 0x00003FFF00003FFF);
+    return ((word & 0x0FFFFFFF00000000) >> 4) | (word & 0x000000000FFFFFFF);
+}
+
+/// Spreads the low 56 bits of `value` into seven-bit groups, one per byte,
+/// undoing `gather_varint_groups`.
+constexpr uint64_t scatter_varint_groups(uint64_t value)
+{
+    value = ((value & 0x00FFFFFFF0000000) << 4) | (value & 0x000000000FFFFFFF);
+    value = ((value & 0x0FFFC0000FFFC000) << 2) | (value & 0x00003FFF00003FFF);
+    return ((value & 0x3F803F803F803F80) << 1) | (value & 0x007F007F007F007F);
+}
+
+} // end detail
+
+/*
+ * VARINTS
+ */
+
+/// The most bytes a varint for `T` takes.
+template <class T>
+constexpr int max_varint_bytes()
+{
+    return (detail::int_traits<T>::width + 6) / 7;
+}
+
+/// Result of `encode_varint`.
+struct encode_varint_result
+{
+    uint8_t* ptr;
+    std::errc ec;
+};
+
+/// Result of `decode_varint`.
+struct decode_varint_result
+{
+    const uint8_t* ptr;
+    std::errc ec;
+};
+
+/// Encodes `value` into `[first, last)` as an LEB128 varint: seven bits per
+/// byte, low bits first, with the high bit of every byte but the last set.
+/// Signed values are zigzag-encoded first, so that small negative values
+/// are short too.
+///
+/// On success returns the end of the varint; if the buffer is too small,
+/// returns `{last, std::errc::value_too_large}`.
+template <class T, template <class> class P>
+encode_varint_result encode_varint(uint8_t* first, uint8_t* last,
+                                   Checked<T, P> value)
+{
+    auto wire = detail::to_varint(value.get());
+
+    int length = detail::varint_length(detail::bit_width(wire));
+    if (last - first < length)
+        return {last, std::errc::value_too_large};
+
+    for (int i = 0; i < length - 1; ++i) {
+        first[i] = uint8_t(wire | 0x80);
+        wire = decltype(wire)(wire >> 7);
+    }
+    first[length - 1] = uint8_t(wire);
+
+    return {first + length, std::errc()};
+}
+
+/// Decodes the varint at the start of `[first, last)` into `value`, as
+/// written by `encode_varint` for `T` or for any type of the same
+/// signedness: a value that does not fit in `T` is handled by policy `P`,
+/// exactly as `Convert` would handle it.
+///
+/// On success returns the end of the varint. If the varint is not
+/// terminated before `last`, returns `{first, std::errc::invalid_argument}`
+/// and leaves `value` unchanged.
+template <class T, template <class> class P>
+decode_varint_result decode_varint(const uint8_t* first, const uint8_t* last,
+                                   Checked<T, P>& value)
+{
+    detail::varint_wire_t<T> wire;
+    bool overflow;
+
+    const uint8_t* end = detail::read_varint(first, last, wire, overflow);
+    if (end == nullptr)
+        return {first, std::errc::invalid_argument};
+
+    value = Checked<T, P>(detail::from_varint<T, P>(wire, overflow));
+    return {end, std::errc()};
+}
+
+/// Result of `encode_varints`.
+struct encode_varints_result
+{
+    /// The end of the written varints.
+    uint8_t* ptr;
+
+    /// The number of values written.
+    std::size_t count;
+};
+
+/// Result of `decode_varints`.
+struct decode_varints_result
+{
+    /// Where decoding stopped: `last`, the start of a varint that is not
+    /// terminated before `last`, or the start of the first varint that did
+    /// not fit in the output.
+    const uint8_t* ptr;
+
+    /// The number of values decoded.
+    std::size_t count;
+};
+
+/// Encodes `values[0]`, ..., `values[size - 1]` into `[first, last)` as by
+/// `encode_varint`, stopping before the first that does not fit.
+///
+/// Where bytes can be written as words, a value of up to 56 bits that needs
+/// more than one byte is spread into its bytes at once and stored as a
+/// whole word, so the bytes between the result's `ptr` and `last` may be
+/// overwritten.
+template <class T, template <class> class P>
+encode_varints_result encode_varints(uint8_t* first, uint8_t* last,
+                                     const Checked<T, P>* values,
+                                     std::size_t size)
+{
+    std::size_t index = 0;
+
+    for (; index < size; ++index) {
+#ifdef XXINT_SWAR_VARINTS
+        auto wire = detail::to_varint(values[index].get());
+        int bits  = detail::bit_width(wire);
+
+        if (bits <= 7 && first != last) {
+            *first++ = uint8_t(wire);
+            continue;
+        }
+
+        if (bits <= 56 && last - first >= 8) {
+            // Every byte but the last continues.
+            int length = detail::varint_length(bits);
+            uint64_t more = 0x0080808080808080 >> (8 * (8 - length));
+            uint64_t word = detail::scatter_varint_groups(uint64_t(wire))
+                            | more;
+            std::memcpy(first, &word, 8);
+            first += length;
+            continue;
+        }
+#endif
+
+        auto result = encode_varint(first, last, values[index]);
+        if (result.ec != std::errc()) break;
+        first = result.ptr;
+    }
+
+    return {first, index};
+}
+
+/// Decodes consecutive varints from `[first, last)` into `out[0]`,
+/// `out[1]`, ..., up to `out[size - 1]`, as by `decode_varint`, stopping at
+/// a varint that is not terminated before `last`. So a stream that arrives
+/// in pieces decodes by moving the bytes from the result's `ptr` to `last`
+/// to the front of the next piece.
+///
+/// Where bytes can be read as words, eight bytes are examined at once: a
+/// run of one-byte varints is converted without range checks when every
+/// one-byte value fits in `T`, and a varint of up to eight bytes has its
+/// seven-bit groups gathered without a loop.
+template <class T, template <class> class P>
+decode_varints_result decode_varints(const uint8_t* first, const uint8_t* last,
+                                     Checked<T, P>* out, std::size_t size)
+{
+    using A = detail::varint_wire_t<T>;
+
+    std::size_t index = 0;
+
+    while (index < size && first != last) {
+#ifdef XXINT_SWAR_VARINTS
+        if (last - first >= 8) {
+            constexpr uint64_t high = 0x8080808080808080;
+            constexpr bool small_fits = detail::int_traits<T>::digits >= 7;
+
+            uint64_t word;
+            std::memcpy(&word, first, 8);
+            uint64_t ends = ~word & high;
+
+            if (small_fits && (ends & 0x80) != 0) {
+                // The bytes before the first continuing one.
+                uint64_t more = word & high;
+                std::size_t run = more == 0 ? 8 : detail::countr_zero(more) / 8;
+                if (run > size - index) run = size - index;
+
+                for (std::size_t i = 0; i < run; ++i)
+                    out[index + i] = Checked<T, P>(
+                            detail::from_small_varint<T>(unsigned(first[i])));
+
+                index += run;
+                first += run;
+                continue;
+            }
+
+            if (ends != 0) {
+                int length = detail::countr_zero(ends) / 8 + 1;
+                uint64_t bytes = length == 8
+                        ? word : word & ((uint64_t(1) << 8 * length) - 1);
+                out[index++] = Checked<T, P>(detail::from_varint<T, P>(
+                        A(detail::gather_varint_groups(bytes)), false));
+                first += length;
+                continue;
+            }
+        }
+#endif
+
+        auto result = decode_varint(first, last, out[index]);
+        if (result.ec != std::errc()) break;
+        first = result.ptr;
+        ++index;
+    }
+
+    return {first, index};
+}
+
+}
+
+#endif
@@ -0,0 +1,467 @@
+#ifndef INT_PLUS_PLUS_VECTOR_H_
+#define INT_PLUS_PLUS_VECTOR_H_
+
+#include "alloc.hxx"
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace xxint {
+
+/*
+ * OVERFLOW TESTS
+ */
+
+namespace detail {
+
+/// Does `a + b` overflow `T`?
+template <class T>
+constexpr bool add_overflows(T a, T b)
+{
+#if __has_builtin(__builtin_add_overflow)
+    T result = 0;
+    return __builtin_add_overflow(a, b, &result);
+#else
+    return b >= 0 ? a > int_traits<T>::max() - b
+                  : a < int_traits<T>::min() - b;
+#endif
+}
+
+/// Does `a - b` overflow `T`?
+template <class T>
+constexpr bool sub_overflows(T a, T b)
+{
+#if __has_builtin(__builtin_sub_overflow)
+    T result = 0;
+    return __builtin_sub_overflow(a, b, &result);
+#else
+    return b >= 0 ? a < int_traits<T>::min() + b
+                  : a > int_traits<T>::max() + b;
+#endif
+}
+
+/// Does `a * b` overflow `T`?
+template <class T>
+constexpr bool mul_overflows(T a, T b)
+{
+#if __has_builtin(__builtin_mul_overflow)
+    T result = 0;
+    return __builtin_mul_overflow(a, b, &result);
+#else
+    // The product fits iff the high half is the sign extension of the low
+    // half.
+    auto product = mul_wide(a, b);
+    T low = static_cast<T>(product.low);
+    return product.high != (low < 0 ? T(-1) : T(0));
+#endif
+}
+
+} // end detail
+
+/*
+ * CHECKED VECTORS
+ */
+
+/// A column of `Checked<T, P>` values, stored as raw `T`s in contiguous
+/// blocks of `block_size`, each aligned for SIMD loads, together with
+/// bounds on each block's values and a bitmap of which of them the policy
+/// has had to handle.
+///
+/// Whole-column arithmetic first asks of each block's bounds whether the
+/// operation can overflow anywhere in the block. If it cannot, as is usual,
+/// the block is updated by a loop without checks, which the compiler can
+/// vectorize, and its bounds are updated from the old ones. Otherwise each
+/// value goes through `Checked<T, P>`'s own arithmetic, which applies
+/// policy `P`, and the values that overflowed are marked in the bitmap.
+///
+/// The bounds may be loose: after an elementwise sum, for example, the
+/// bounds are the sums of the operands' bounds. A block whose bounds grow
+/// too loose is checked value by value, which makes its bounds exact
+/// again.
+///
+/// If the policy throws, values before the one that overflowed will have
+/// been updated.
+template <class T, template <class> class P = policy::throwing>
+class CheckedVector
+{
+public:
+    /// The type of the column's values.
+    using value_type = Checked<T, P>;
+
+    /// The number of values in each block.
+    static constexpr std::size_t block_size = 256;
+
+    /// The alignment of each block in bytes.
+    static constexpr std::size_t alignment = 64;
+
+    /// An empty column.
+    CheckedVector() = default;
+
+    /// A column of `size` copies of `value`.
+    explicit CheckedVector(std::size_t size, value_type value = value_type())
+    {
+        reserve(size);
+        for (std::size_t i = 0; i < size; ++i)
+            data_[i] = value.get();
+        size_ = size;
+        bounds_.assign(blocks(), {value.get(), value.get()});
+        overflow_.assign(blocks() * words_per_block_, 0);
+    }
+
+    /// A column of `values`.
+    CheckedVector(std::initializer_list<value_type> values)
+    {
+        reserve(values.size());
+        for (auto each : values)
+            push_back(each);
+    }
+
+    CheckedVector(const CheckedVector& other)
+            : bounds_(other.bounds_), overflow_(other.overflow_)
+    {
+        reserve(other.size_);
+        if (other.size_ != 0)
+            std::memcpy(data_, other.data_, other.size_ * sizeof(T));
+        size_ = other.size_;
+    }
+
+    CheckedVector(CheckedVector&& other) noexcept
+    {
+        swap(other);
+    }
+
+    CheckedVector& operator=(CheckedVector other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    ~CheckedVector()
+    {
+        ::operator delete(storage_);
+    }
+
+    void swap(CheckedVector& other) noexcept
+    {
+        std::swap(storage_, other.storage_);
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        bounds_.swap(other.bounds_);
+        overflow_.swap(other.overflow_);
+    }
+
+    /// The number of values.
+    std::size_t size() const { return size_; }
+
+    /// Is the column empty?
+    bool empty() const { return size_ == 0; }
+
+    /// The number of blocks, the last of which may be partly full.
+    std::size_t blocks() const
+    {
+        return (size_ + block_size - 1) / block_size;
+    }
+
+    /// The raw values.
+    const T* data() const { return data_; }
+
+    /// The value at `index`.
+    value_type operator[](std::size_t index) const
+    {
+        return value_type(data_[index]);
+    }
+
+    /// A lower bound on the values in block `block`.
+    T block_min(std::size_t block) const { return bounds_[block].min; }
+
+    /// An upper bound on the values in block `block`.
+    T block_max(std::size_t block) const { return bounds_[block].max; }
+
+    /// Was the value at `index` produced by policy `P` on overflow, rather
+    /// than by exact arithmetic, since it was set?
+    bool overflowed(std::size_t index) const
+    {
+        return (word_(index) >> index % 64 & 1) != 0;
+    }
+
+    /// Were any of the values produced by policy `P` on overflow?
+    bool any_overflowed() const
+    {
+        for (auto word : overflow_)
+            if (word != 0) return true;
+        return false;
+    }
+
+    /// Sets the value at `index` to `value`, widening its block's bounds to
+    /// include it and clearing its overflow mark.
+    void set(std::size_t index, value_type value)
+    {
+        data_[index] = value.get();
+        include_(bounds_[index / block_size], value.get());
+        word_(index) &= ~(uint64_t(1) << index % 64);
+    }
+
+    /// Makes room for at least `size` values.
+    void reserve(std::size_t size)
+    {
+        if (size > capacity_) grow_(size);
+    }
+
+    /// Appends `value`.
+    void push_back(value_type value)
+    {
+        if (size_ == capacity_) grow_(2 * capacity_);
+        if (size_ % block_size == 0) {
+            bounds_.push_back({value.get(), value.get()});
+            overflow_.resize(overflow_.size() + words_per_block_, 0);
+        }
+        data_[size_] = value.get();
+        include_(bounds_.back(), value.get());
+        ++size_;
+    }
+
+    /// Adds `other` to every value.
+    CheckedVector& operator+=(value_type other)
+    {
+        T c = other.get();
+        for (std::size_t b = 0; b < blocks(); ++b) {
+            auto& bounds = bounds_[b];
+            if (detail::add_overflows(bounds.min, c)
+                    || detail::add_overflows(bounds.max, c)) {
+                check_block_(b, [=](T x, std::size_t) {
+                    return std::make_pair(detail::add_overflows(x, c),
+                                          value_type(x) + other);
+                });
+            } else {
+                update_block_(b, [=](W x) { return x + W(c); });
+                bounds = {T(bounds.min + c), T(bounds.max + c)};
+            }
+        }
+        return *this;
+    }
+
+    /// Subtracts `other` from every value.
+    CheckedVector& operator-=(value_type other)
+    {
+        T c = other.get();
+        for (std::size_t b = 0; b < blocks(); ++b) {
+            auto& bounds = bounds_[b];
+            if (detail::sub_overflows(bounds.min, c)
+                    || detail::sub_overflows(bounds.max, c)) {
+                check_block_(b, [=](T x, std::size_t) {
+                    return std::make_pair(detail::sub_overflows(x, c),
+                                          value_type(x) - other);
+                });
+            } else {
+                update_block_(b, [=](W x) { return x - W(c); });
+                bounds = {T(bounds.min - c), T(bounds.max - c)};
+            }
+        }
+        return *this;
+    }
+
+    /// Multiplies every value by `other`.
+    CheckedVector& operator*=(value_type other)
+    {
+        T c = other.get();
+        for (std::size_t b = 0; b < blocks(); ++b) {
+            auto& bounds = bounds_[b];
+            if (detail::mul_overflows(bounds.min, c)
+                    || detail::mul_overflows(bounds.max, c)) {
+                check_block_(b, [=](T x, std::size_t) {
+                    return std::make_pair(detail::mul_overflows(x, c),
+                                          value_type(x) * other);
+                });
+            } else {
+                update_block_(b, [=](W x) { return x * W(c); });
+                T lo = T(bounds.min * c), hi = T(bounds.max * c);
+                bounds = c < 0 ? bounds_t{hi, lo} : bounds_t{lo, hi};
+            }
+        }
+        return *this;
+    }
+
+    /// Adds each value of `other` to the corresponding value. Throws
+    /// `std::invalid_argument` if the sizes differ.
+    CheckedVector& operator+=(const CheckedVector& other)
+    {
+        check_size_(other);
+        for (std::size_t b = 0; b < blocks(); ++b) {
+            auto& bounds = bounds_[b];
+            auto theirs = other.bounds_[b];
+            if (detail::add_overflows(bounds.min, theirs.min)
+                    || detail::add_overflows(bounds.max, theirs.max)) {
+                check_block_(b, [&](T x, std::size_t i) {
+                    T y = other.data_[i];
+                    return std::make_pair(detail::add_overflows(x, y),
+                                          value_type(x) + value_type(y));
+                });
+            } else {
+                update_block_(b, other, [](W x, W y) { return x + y; });
+                bounds = {T(bounds.min + theirs.min),
+                          T(bounds.max + theirs.max)};
+            }
+        }
+        return *this;
+    }
+
+    /// Subtracts each value of `other` from the corresponding value. Throws
+    /// `std::invalid_argument` if the sizes differ.
+    CheckedVector& operator-=(const CheckedVector& other)
+    {
+        check_size_(other);
+        for (std::size_t b = 0; b < blocks(); ++b) {
+            auto& bounds = bounds_[b];
+            auto theirs = other.bounds_[b];
+            if (detail::sub_overflows(bounds.min, theirs.max)
+                    || detail::sub_overflows(bounds.max, theirs.min)) {
+                check_block_(b, [&](T x, std::size_t i) {
+                    T y = other.data_[i];
+                    return std::make_pair(detail::sub_overflows(x, y),
+                                          value_type(x) - value_type(y));
+                });
+            } else {
+                update_block_(b, other, [](W x, W y) { return x - y; });
+                bounds = {T(bounds.min - theirs.max),
+                          T(bounds.max - theirs.min)};
+            }
+        }
+        return *this;
+    }
+
+private:
+    /// Unsigned arithmetic on `T`, which wraps rather than overflowing.
+    using W = detail::promoted_unsigned_t<detail::make_unsigned_t<T>>;
+
+    struct bounds_t
+    {
+        T min;
+        T max;
+    };
+
+    static constexpr std::size_t words_per_block_ = block_size / 64;
+
+    void* storage_ = nullptr;
+    T* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t capacity_ = 0;
+    std::vector<bounds_t> bounds_;
+    std::vector<uint64_t> overflow_;
+
+    uint64_t& word_(std::size_t index)
+    {
+        return overflow_[index / 64];
+    }
+
+    uint64_t word_(std::size_t index) const
+    {
+        return overflow_[index / 64];
+    }
+
+    static void include_(bounds_t& bounds, T value)
+    {
+        if (value < bounds.min) bounds.min = value;
+        if (value > bounds.max) bounds.max = value;
+    }
+
+    void check_size_(const CheckedVector& other) const
+    {
+        if (other.size_ != size_)
+            throw std::invalid_argument("CheckedVector: different sizes");
+    }
+
+    /// Reallocates room for at least `size` values, in whole blocks, with
+    /// the values past the end zeroed.
+    void grow_(std::size_t size)
+    {
+        std::size_t blocks = (size + block_size - 1) / block_size;
+        if (blocks == 0) blocks = 1;
+        Checked<std::size_t> capacity = Checked<std::size_t>(blocks)
+                                        * block_size;
+
+        void* storage = ::operator new(
+                alloc_size<T>(capacity, alignment - 1).get());
+        auto address = reinterpret_cast<std::uintptr_t>(storage);
+        T* data = reinterpret_cast<T*>(
+                (address + alignment - 1) & ~std::uintptr_t(alignment - 1));
+
+        std::memset(data, 0, capacity.get() * sizeof(T));
+        if (size_ != 0) std::memcpy(data, data_, size_ * sizeof(T));
+
+        ::operator delete(storage_);
+        storage_  = storage;
+        data_     = data;
+        capacity_ = capacity.get();
+    }
+
+    /// Applies `f` to every value of block `block`, without checks. The
+    /// values past the end of the last block are updated too, so that
+    /// every block is a whole number of SIMD vectors; they are never read.
+    template <class F>
+    void update_block_(std::size_t block, F f)
+    {
+        T* values = data_ + block * block_size;
+        for (std::size_t i = 0; i < block_size; ++i)
+            values[i] = static_cast<T>(f(W(values[i])));
+    }
+
+    /// Applies `f` to every value of block `block` and the corresponding
+    /// value of `other`, without checks. `other`'s values are copied a row
+    /// at a time, so that the compiler need not consider whether the two
+    /// blocks overlap.
+    template <class F>
+    void update_block_(std::size_t block, const CheckedVector& other, F f)
+    {
+        constexpr std::size_t lanes = alignment / sizeof(T);
+
+        T* values = data_ + block * block_size;
+        const T* theirs = other.data_ + block * block_size;
+        for (std::size_t i = 0; i < block_size; i += lanes) {
+            W row[lanes];
+            for (std::size_t j = 0; j < lanes; ++j)
+                row[j] = W(theirs[i + j]);
+            for (std::size_t j = 0; j < lanes; ++j)
+                values[i + j] = static_cast<T>(f(W(values[i + j]), row[j]));
+        }
+    }
+
+    /// Replaces every value `x`, at `i`, of block `block` by `f(x, i)`'s
+    /// second, a `value_type`, marking it as overflowed if the first is
+    /// true, and makes the block's bounds exact.
+    template <class F>
+    void check_block_(std::size_t block, F f)
+    {
+        std::size_t first = block * block_size;
+        std::size_t last  = std::min(first + block_size, size_);
+
+        // Until the block is done, the policy may throw part way through.
+        auto& bounds = bounds_[block];
+        bounds = {detail::int_traits<T>::min(), detail::int_traits<T>::max()};
+
+        bounds_t exact{detail::int_traits<T>::max(),
+                       detail::int_traits<T>::min()};
+        for (std::size_t i = first; i < last; ++i) {
+            auto result = f(data_[i], i);
+            data_[i] = result.second.get();
+            word_(i) |= uint64_t(result.first) << i % 64;
+            include_(exact, data_[i]);
+        }
+
+        bounds = exact;
+    }
+};
+
+template <class T, template <class> class P>
+constexpr std::size_t CheckedVector<T, P>::block_size;
+
+template <class T, template <class> class P>
+constexpr std::size_t CheckedVector<T, P>::alignment;
+
+}
+
+#endif
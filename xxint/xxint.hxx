@@ -3,8 +3,12 @@
 
 #include <iostream>
 #include <climits>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <limits>
 #include <stdexcept>
+#include <system_error>
 
 /// Namespace for int++.
 namespace xxint {
@@ -31,6 +35,248 @@ struct overflow_div_zero : std::overflow_error
     using overflow_error::overflow_error;
 };
 
+/*
+ * INTEGER TRAITS
+ */
+
+#if defined(__clang__) && defined(__BITINT_MAXWIDTH__)
+/// Defined when the compiler provides `_BitInt(N)`, in which case `Checked`,
+/// `Convert`, and the range helpers accept bit-precise integer types.
+#  define XXINT_HAS_BIT_INT 1
+#endif
+
+#if defined(__SIZEOF_INT128__)
+/// Defined when the compiler provides a 128-bit integer type, which serves
+/// as the double-width intermediate for 64-bit operands.
+#  define XXINT_HAS_INT128 1
+#endif
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+/// Defined when bytes in memory are little-endian, so that a byte buffer
+/// can be read a 64-bit word at a time with its first byte lowest.
+#  define XXINT_LITTLE_ENDIAN 1
+#endif
+
+namespace detail {
+
+/// Describes the range of an arithmetic type `T`.
+///
+/// The width is measured in value bits rather than derived from `sizeof`,
+/// so that types with padding bits, such as `_BitInt(24)`, are described
+/// by their actual range.
+template <class T, class Enable = void>
+struct int_traits
+{
+    /// Can the type represent negative values?
+    static constexpr bool is_signed = std::is_signed<T>::value;
+
+    /// Number of non-sign value bits.
+    static constexpr int digits =
+            std::is_integral<T>::value
+            ? std::numeric_limits<T>::digits
+            : int(sizeof(T) * CHAR_BIT) - is_signed;
+
+    /// Total number of bits, including the sign bit.
+    static constexpr int width = digits + is_signed;
+
+    /// The smallest value of the type.
+    static constexpr T min()
+    {
+        return std::numeric_limits<T>::min();
+    }
+
+    /// The largest value of the type.
+    static constexpr T max()
+    {
+        return std::numeric_limits<T>::max();
+    }
+};
+
+template <class T, class Enable>
+constexpr bool int_traits<T, Enable>::is_signed;
+
+template <class T, class Enable>
+constexpr int int_traits<T, Enable>::digits;
+
+template <class T, class Enable>
+constexpr int int_traits<T, Enable>::width;
+
+/// Gets the unsigned counterpart of integer type `T`.
+template <class T, class Enable = void>
+struct make_unsigned : std::make_unsigned<T>
+{ };
+
+#ifdef XXINT_HAS_BIT_INT
+/// Range of a signed bit-precise integer.
+template <int N>
+struct int_traits<_BitInt(N)>
+{
+    static constexpr bool is_signed = true;
+    static constexpr int digits = N - 1;
+    static constexpr int width = N;
+
+    static constexpr _BitInt(N) max()
+    {
+        return static_cast<_BitInt(N)>(
+                (static_cast<unsigned _BitInt(N)>(1) << (N - 1)) - 1);
+    }
+
+    static constexpr _BitInt(N) min()
+    {
+        return -max() - 1;
+    }
+};
+
+/// Range of an unsigned bit-precise integer.
+template <int N>
+struct int_traits<unsigned _BitInt(N)>
+{
+    static constexpr bool is_signed = false;
+    static constexpr int digits = N;
+    static constexpr int width = N;
+
+    static constexpr unsigned _BitInt(N) min()
+    {
+        return 0;
+    }
+
+    static constexpr unsigned _BitInt(N) max()
+    {
+        return ~static_cast<unsigned _BitInt(N)>(0);
+    }
+};
+
+template <int N> constexpr bool int_traits<_BitInt(N)>::is_signed;
+template <int N> constexpr int  int_traits<_BitInt(N)>::digits;
+template <int N> constexpr int  int_traits<_BitInt(N)>::width;
+template <int N> constexpr bool int_traits<unsigned _BitInt(N)>::is_signed;
+template <int N> constexpr int  int_traits<unsigned _BitInt(N)>::digits;
+template <int N> constexpr int  int_traits<unsigned _BitInt(N)>::width;
+
+template <int N>
+struct make_unsigned<_BitInt(N)>
+{
+    using type = unsigned _BitInt(N);
+};
+
+template <int N>
+struct make_unsigned<unsigned _BitInt(N)>
+{
+    using type = unsigned _BitInt(N);
+};
+#endif // XXINT_HAS_BIT_INT
+
+#ifdef XXINT_HAS_INT128
+__extension__ typedef __int128 int128_t;
+__extension__ typedef unsigned __int128 uint128_t;
+
+/// Range of the 128-bit signed integer, which the standard library does not
+/// describe in strict ISO mode.
+template <>
+struct int_traits<int128_t>
+{
+    static constexpr bool is_signed = true;
+    static constexpr int digits = 127;
+    static constexpr int width = 128;
+
+    static constexpr int128_t max()
+    {
+        return static_cast<int128_t>(~uint128_t(0) >> 1);
+    }
+
+    static constexpr int128_t min()
+    {
+        return -max() - 1;
+    }
+};
+
+/// Range of the 128-bit unsigned integer.
+template <>
+struct int_traits<uint128_t>
+{
+    static constexpr bool is_signed = false;
+    static constexpr int digits = 128;
+    static constexpr int width = 128;
+
+    static constexpr uint128_t min()
+    {
+        return 0;
+    }
+
+    static constexpr uint128_t max()
+    {
+        return ~uint128_t(0);
+    }
+};
+
+template <>
+struct make_unsigned<int128_t>
+{
+    using type = uint128_t;
+};
+
+template <>
+struct make_unsigned<uint128_t>
+{
+    using type = uint128_t;
+};
+#endif // XXINT_HAS_INT128
+
+/// Converts `value` to a type that has a stream insertion operator.
+template <class T>
+constexpr T streamable(T value)
+{
+    return value;
+}
+
+#ifdef XXINT_HAS_BIT_INT
+template <int N>
+constexpr std::conditional_t<N <= 64, long long, _BitInt(N)>
+streamable(_BitInt(N) value)
+{
+    return value;
+}
+
+template <int N>
+constexpr std::conditional_t<N <= 64, unsigned long long, unsigned _BitInt(N)>
+streamable(unsigned _BitInt(N) value)
+{
+    return value;
+}
+#endif // XXINT_HAS_BIT_INT
+
+/// Alias for `make_unsigned<T>::type`.
+template <class T>
+using make_unsigned_t = typename make_unsigned<T>::type;
+
+/// The narrowest standard integer type with at least `Width` bits and the
+/// given signedness, or `void` if there is none.
+template <int Width, bool Signed>
+using least_int_t =
+    std::conditional_t<(Width <= 8),
+        std::conditional_t<Signed, int8_t, uint8_t>,
+    std::conditional_t<(Width <= 16),
+        std::conditional_t<Signed, int16_t, uint16_t>,
+    std::conditional_t<(Width <= 32),
+        std::conditional_t<Signed, int32_t, uint32_t>,
+    std::conditional_t<(Width <= 64),
+        std::conditional_t<Signed, int64_t, uint64_t>,
+#ifdef XXINT_HAS_INT128
+    std::conditional_t<(Width <= 128),
+        std::conditional_t<Signed, int128_t, uint128_t>,
+        void>
+#else
+        void
+#endif
+    >>>>;
+
+/// An integer type at least twice as wide as `T`, with the same signedness,
+/// so that it can hold the exact product of any two `T`s.
+template <class T>
+using wider_t = least_int_t<2 * int_traits<T>::width, int_traits<T>::is_signed>;
+
+} // end detail
+
 /*
  * POLICIES
  */
@@ -66,14 +312,14 @@ struct saturating
     /// too large.
     static constexpr T too_large(const char*)
     {
-        return std::numeric_limits<T>::max();
+        return detail::int_traits<T>::max();
     }
 
     /// Returns the smallest value of the type for when the result would be
     /// too small.
     static T constexpr too_small(const char*)
     {
-        return std::numeric_limits<T>::min();
+        return detail::int_traits<T>::min();
     }
 
     /// Throws an `overflow_div_zero` exception.
@@ -132,38 +378,29 @@ struct wrapping
 
 namespace detail {
 
-/// Is type `A` wide enough to hold ever value of type `B`?
-template<class A, class B>
-constexpr bool is_as_wide_as()
-{
-    if (std::is_signed<B>::value == std::is_signed<A>::value)
-        return sizeof(B) <= sizeof(A);
-
-    if (std::is_unsigned<B>::value && std::is_signed<A>::value)
-        return sizeof(B) < sizeof(A);
-
-    return false;
-}
-
 /// Does type `A` include values lower than `B_MIN`?
 template<class A, class B>
 constexpr bool goes_lower_than()
 {
-    if (std::is_unsigned<A>::value) return false;
+    if (!int_traits<A>::is_signed) return false;
 
-    if (std::is_unsigned<B>::value) return true;
+    if (!int_traits<B>::is_signed) return true;
 
-    return sizeof(A) > sizeof(B);
+    return int_traits<A>::digits > int_traits<B>::digits;
 }
 
 /// Does type `A` include values higher than `B_MAX`?
 template<class A, class B>
 constexpr bool goes_higher_than()
 {
-    if (sizeof(A) == sizeof(B))
-        return std::is_unsigned<A>::value && std::is_signed<B>::value;
+    return int_traits<A>::digits > int_traits<B>::digits;
+}
 
-    return sizeof(A) > sizeof(B);
+/// Is type `A` wide enough to hold ever value of type `B`?
+template<class A, class B>
+constexpr bool is_as_wide_as()
+{
+    return !goes_lower_than<B, A>() && !goes_higher_than<B, A>();
 }
 
 /// Gets the minimum value of type `T` in type `Repr`.
@@ -173,7 +410,7 @@ template<class T, class Repr>
 constexpr Repr
 min_as()
 {
-    return static_cast<Repr>(std::numeric_limits<T>::min());
+    return static_cast<Repr>(int_traits<T>::min());
 }
 
 /// Gets the maximum value of type `T` in type `Repr`.
@@ -183,7 +420,7 @@ template<class T, class Repr>
 constexpr Repr
 max_as()
 {
-    return static_cast<Repr>(std::numeric_limits<T>::max());
+    return static_cast<Repr>(int_traits<T>::max());
 }
 
 /// Is `from` too small to fit in type `To`?
@@ -328,8 +565,8 @@ struct Convert<To, From, Policy,
     /// policy `Policy`.
     static constexpr To convert(From from)
     {
-        using UFrom = std::make_unsigned_t<From>;
-        using UTo   = std::make_unsigned_t<From>;
+        using UFrom = detail::make_unsigned_t<From>;
+        using UTo   = detail::make_unsigned_t<To>;
 
         return static_cast<To>(static_cast<UTo>(static_cast<UFrom>(from)));
     }
@@ -356,6 +593,344 @@ constexpr To convert_widen(From from)
     return Convert<To, From, policy::throwing>::widen(from);
 }
 
+/*
+ * ROUNDING
+ */
+
+/// Rounding modes for operations that discard low-order digits, such as
+/// fixed-point multiplication and rescaling.
+enum class rounding
+{
+    /// Rounds toward zero, like built-in integer division.
+    toward_zero,
+    /// Rounds toward negative infinity.
+    floor,
+    /// Rounds toward positive infinity.
+    ceil,
+    /// Rounds to nearest, with ties away from zero.
+    nearest,
+    /// Rounds to nearest, with ties to even ("banker's rounding").
+    nearest_even,
+};
+
+namespace detail {
+
+/// The absolute value of `value`, as an unsigned type.
+template <class T>
+constexpr make_unsigned_t<T> magnitude(T value)
+{
+    using U = make_unsigned_t<T>;
+    return value < 0 ? U(U(0) - U(value)) : U(value);
+}
+
+/// Divides `num` by `den`, rounding according to `R`.
+///
+/// PRECONDITION: `den != 0` and the quotient fits in `T`.
+template <rounding R, class T>
+constexpr T div_round(T num, T den)
+{
+    T quot = num / den;
+    T rem  = num % den;
+
+    if (rem == 0) return quot;
+
+    // The direction away from zero.
+    bool negative = (rem < 0) != (den < 0);
+    T away = negative ? T(quot - 1) : T(quot + 1);
+
+    switch (R) {
+    case rounding::toward_zero:
+        return quot;
+    case rounding::floor:
+        return negative ? away : quot;
+    case rounding::ceil:
+        return negative ? quot : away;
+    case rounding::nearest:
+    case rounding::nearest_even: {
+        auto r    = magnitude(rem);
+        auto rest = magnitude(den) - r;
+        if (r < rest) return quot;
+        if (r > rest) return away;
+        if (R == rounding::nearest || (quot & 1) != 0) return away;
+        return quot;
+    }
+    }
+
+    return quot;
+}
+
+/// Shifts `value` right by `shift` bits, rounding according to `R`.
+///
+/// PRECONDITION: `0 <= shift < int_traits<T>::width`
+template <rounding R, class T>
+constexpr T shift_round(T value, int shift)
+{
+    using U = make_unsigned_t<T>;
+
+    if (shift == 0) return value;
+
+    // Arithmetic shift rounds toward negative infinity; rounding up from
+    // there cannot overflow since `quot <= max >> 1`.
+    T quot = value >> shift;
+    U rem  = U(value) & U((U(1) << shift) - 1);
+    U half = U(1) << (shift - 1);
+
+    if (rem == 0) return quot;
+
+    T up = T(quot + 1);
+
+    switch (R) {
+    case rounding::floor:
+        return quot;
+    case rounding::ceil:
+        return up;
+    case rounding::toward_zero:
+        return value < 0 ? up : quot;
+    case rounding::nearest:
+    case rounding::nearest_even:
+        if (rem < half) return quot;
+        if (rem > half) return up;
+        if (R == rounding::nearest)
+            return value < 0 ? quot : up;
+        return (quot & 1) != 0 ? up : quot;
+    }
+
+    return quot;
+}
+
+} // end detail
+
+/*
+ * WIDE ARITHMETIC
+ */
+
+/// The exact product of two `T`s, as returned by `mul_wide`. Its value is
+/// `high * 2^w + low`, where `w` is the width of `T`.
+template <class T>
+struct wide_product
+{
+    /// The high half, which carries the sign if `T` is signed.
+    T high;
+    /// The low half.
+    detail::make_unsigned_t<T> low;
+};
+
+namespace detail {
+
+/// Unsigned arithmetic on `T` without promotion to (signed) `int`.
+template <class T>
+using promoted_unsigned_t = std::common_type_t<T, unsigned>;
+
+/// The low half of the product of `a` and `b`.
+template <class U>
+constexpr U mul_low(U a, U b)
+{
+    return U(promoted_unsigned_t<U>(a) * promoted_unsigned_t<U>(b));
+}
+
+/// The high half of the product of `a` and `b`, using a double-width type.
+template <class U>
+constexpr U mul_high(U a, U b, std::true_type /* has wider type */)
+{
+    using W = wider_t<U>;
+    return U(mul_low<W>(a, b) >> int_traits<U>::width);
+}
+
+/// The high half of the product of `a` and `b`, by schoolbook
+/// multiplication of half-width digits.
+template <class U>
+constexpr U mul_high(U a, U b, std::false_type /* has wider type */)
+{
+    constexpr int half = int_traits<U>::width / 2;
+    constexpr U mask = (U(1) << half) - 1;
+
+    U a0 = a & mask, a1 = a >> half;
+    U b0 = b & mask, b1 = b >> half;
+
+    U p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    U mid = (p00 >> half) + (p01 & mask) + (p10 & mask);
+
+    return p11 + (p01 >> half) + (p10 >> half) + (mid >> half);
+}
+
+/// The high half of the unsigned product of `a` and `b`.
+template <class U>
+constexpr U mul_high(U a, U b)
+{
+    return mul_high(a, b, std::integral_constant<bool,
+                            !std::is_void<wider_t<U>>::value>());
+}
+
+template <class U>
+constexpr int countr_zero(U x);
+
+template <class U>
+constexpr int bit_width(U x);
+
+/// The number of trailing zero bits in `x`, for `x` no wider than
+/// `unsigned long long`.
+///
+/// PRECONDITION: `x != 0`
+template <class U>
+constexpr int countr_zero(U x, std::true_type /* fits in a word */)
+{
+#if __has_builtin(__builtin_ctzll)
+    return __builtin_ctzll(static_cast<unsigned long long>(x));
+#else
+    int n = 0;
+    while ((x & 1) == 0) { x >>= 1; ++n; }
+    return n;
+#endif
+}
+
+/// The number of trailing zero bits in `x`, a word at a time.
+template <class U>
+constexpr int countr_zero(U x, std::false_type /* fits in a word */)
+{
+    constexpr int word = int_traits<unsigned long long>::width;
+    auto low = static_cast<unsigned long long>(x);
+    return low != 0 ? countr_zero(low, std::true_type())
+                    : word + countr_zero(U(x >> word));
+}
+
+/// The number of trailing zero bits in unsigned `x`.
+///
+/// PRECONDITION: `x != 0`
+template <class U>
+constexpr int countr_zero(U x)
+{
+    return countr_zero(x, std::integral_constant<bool,
+        (int_traits<U>::width <= int_traits<unsigned long long>::width)>());
+}
+
+/// The number of bits needed to represent `x`, for `x` no wider than
+/// `unsigned long long`.
+template <class U>
+constexpr int bit_width(U x, std::true_type /* fits in a word */)
+{
+#if __has_builtin(__builtin_clzll)
+    return x == 0 ? 0 : int_traits<unsigned long long>::width
+                        - __builtin_clzll(static_cast<unsigned long long>(x));
+#else
+    int n = 0;
+    while (x != 0) { x >>= 1; ++n; }
+    return n;
+#endif
+}
+
+/// The number of bits needed to represent `x`, a word at a time.
+template <class U>
+constexpr int bit_width(U x, std::false_type /* fits in a word */)
+{
+    constexpr int word = int_traits<unsigned long long>::width;
+    U high = U(x >> word);
+    return high != 0
+        ? word + bit_width(high)
+        : bit_width(static_cast<unsigned long long>(x), std::true_type());
+}
+
+/// The number of bits needed to represent unsigned `x`; 0 for 0.
+template <class U>
+constexpr int bit_width(U x)
+{
+    return bit_width(x, std::integral_constant<bool,
+        (int_traits<U>::width <= int_traits<unsigned long long>::width)>());
+}
+
+} // end detail
+
+namespace detail {
+
+/// The exact product of `a` and `b`, formed in a double-width type.
+template <class T>
+constexpr wide_product<T> mul_wide(T a, T b, std::true_type /* has wider type */)
+{
+    using W = wider_t<T>;
+    using U = make_unsigned_t<T>;
+
+    W product = static_cast<W>(static_cast<W>(a) * static_cast<W>(b));
+    return {static_cast<T>(product >> int_traits<T>::width),
+            static_cast<U>(product)};
+}
+
+/// The exact product of `a` and `b`, from the unsigned halves.
+template <class T>
+constexpr wide_product<T> mul_wide(T a, T b, std::false_type /* has wider type */)
+{
+    using U = make_unsigned_t<T>;
+
+    U low  = mul_low<U>(U(a), U(b));
+    U high = mul_high<U>(U(a), U(b));
+
+    // Reading a negative operand as unsigned adds 2^w to it, and so adds
+    // the other operand to the high half.
+    if (a < 0) high = U(high - U(b));
+    if (b < 0) high = U(high - U(a));
+
+    return {static_cast<T>(high), low};
+}
+
+} // end detail
+
+/// The exact double-width product of `a` and `b`.
+///
+/// This uses a double-width type when there is one, and otherwise
+/// multiplies half-width digits, so it also works for the widest type.
+template <class T>
+constexpr wide_product<T> mul_wide(T a, T b)
+{
+    return detail::mul_wide(a, b, std::integral_constant<bool,
+                                    !std::is_void<detail::wider_t<T>>::value>());
+}
+
+/// Adds `a`, `b` and `carry_in`, returning the low half of the sum and
+/// storing the carry out of the top bit in `carry_out`. `T` must be
+/// unsigned. `carry_in` and `carry_out` may be the same variable, so a
+/// multiword sum is a chain of calls, which compilers can lower to
+/// `add`/`adc`.
+template <class T>
+constexpr T add_carry(T a, T b, bool carry_in, bool& carry_out)
+{
+    static_assert(!detail::int_traits<T>::is_signed,
+                  "add_carry: T must be unsigned");
+
+#if __has_builtin(__builtin_add_overflow)
+    T sum = 0, result = 0;
+    bool c1 = __builtin_add_overflow(a, b, &sum);
+    bool c2 = __builtin_add_overflow(sum, T(carry_in), &result);
+    carry_out = c1 | c2;
+    return result;
+#else
+    T sum    = T(a + b);
+    T result = T(sum + T(carry_in));
+    carry_out = (sum < a) | (result < sum);
+    return result;
+#endif
+}
+
+/// Subtracts `b` and `borrow_in` from `a`, returning the low half of the
+/// difference and storing the borrow out of the top bit in `borrow_out`.
+/// `T` must be unsigned. Chains can be lowered to `sub`/`sbb`.
+template <class T>
+constexpr T sub_borrow(T a, T b, bool borrow_in, bool& borrow_out)
+{
+    static_assert(!detail::int_traits<T>::is_signed,
+                  "sub_borrow: T must be unsigned");
+
+#if __has_builtin(__builtin_sub_overflow)
+    T diff = 0, result = 0;
+    bool b1 = __builtin_sub_overflow(a, b, &diff);
+    bool b2 = __builtin_sub_overflow(diff, T(borrow_in), &result);
+    borrow_out = b1 | b2;
+    return result;
+#else
+    T diff   = T(a - b);
+    T result = T(diff - T(borrow_in));
+    borrow_out = (a < b) | (diff < T(borrow_in));
+    return result;
+#endif
+}
+
 /*
  * CHECKED INTEGERS
  */
@@ -370,16 +945,16 @@ class Checked;
 /// Non-wrapping, signed integers.
 template <class T, template<class> class P>
 class Checked<T, P,
-        std::enable_if_t<std::is_signed<T>::value && !P<T>::is_wrapping>>
+        std::enable_if_t<detail::int_traits<T>::is_signed && !P<T>::is_wrapping>>
 {
 private:
-    using unsigned_t = std::make_unsigned_t<T>;
+    using unsigned_t = detail::make_unsigned_t<T>;
     using policy_t   = P<T>;
 
     T value_;
 
-    static constexpr T T_MIN_ = std::numeric_limits<T>::min();
-    static constexpr T T_MAX_ = std::numeric_limits<T>::max();
+    static constexpr T T_MIN_ = detail::int_traits<T>::min();
+    static constexpr T T_MAX_ = detail::int_traits<T>::max();
 
     template <typename U>
     static constexpr Checked rebuild_(U value)
@@ -422,7 +997,7 @@ public:
     /// Checked negation.
     constexpr Checked operator-() const
     {
-        if (std::is_signed<T>::value && value_ == T_MIN_)
+        if (value_ == T_MIN_)
             return policy_t::too_large("Checked::operator-()");
         else
             return rebuild_(-value_);
@@ -432,7 +1007,7 @@ public:
     constexpr unsigned_t abs() const
     {
         if (value_ == T_MIN_) {
-            return unsigned_t(std::numeric_limits<T>::max()) + 1;
+            return unsigned_t(detail::int_traits<T>::max()) + 1;
         } else if (value_ < 0) {
             return unsigned_t(-value_);
         } else {
@@ -510,15 +1085,14 @@ public:
             return result;
         }
 #else
-        // This is slow right now, because it does a division. There are better
-        // ways of doing it, depending on the size of T.
-        if (other.value_ != 0) {
-            if (abs() > unsigned_t(T_MAX_) / other.abs()) {
-                return overflow();
-            }
-        }
+        // The product fits iff the high half is the sign extension of the
+        // low half.
+        auto product = mul_wide(value_, other.value_);
+        T low = static_cast<T>(product.low);
+        if (product.high != (low < 0 ? T(-1) : T(0)))
+            return overflow();
 
-        return rebuild_(value_ * other.value_);
+        return rebuild_(low);
 #endif
     }
 
@@ -570,11 +1144,11 @@ public:
             return rebuild_(0);
 
         if (value_ > 0) {
-            if (other >= sizeof(T) * CHAR_BIT
+            if (other >= detail::int_traits<T>::width
                 || T_MAX_ >> other < value_)
                 return policy_t::too_large("Checked::operator<<(u_int8_t)");
         } else {
-            if (other >= sizeof(T) * CHAR_BIT
+            if (other >= detail::int_traits<T>::width
                 || T_MIN_ >> other > value_)
                 return policy_t::too_small("Checked::operation<<(u_int8_t)");
         }
@@ -686,14 +1260,14 @@ public:
 /// Non-wrapping, unsigned integers.
 template <class T, template <class> class P>
 class Checked<T, P,
-        std::enable_if_t<std::is_unsigned<T>::value && !P<T>::is_wrapping>>
+        std::enable_if_t<!detail::int_traits<T>::is_signed && !P<T>::is_wrapping>>
 {
 private:
     using policy_t   = P<T>;
 
     T value_;
 
-    static constexpr T T_MAX_ = std::numeric_limits<T>::max();
+    static constexpr T T_MAX_ = detail::int_traits<T>::max();
 
     template <typename U>
     static constexpr Checked rebuild_(U value)
@@ -786,14 +1360,11 @@ public:
             return result;
         }
 #else
-        // This is slow right now, because it does a division. There are better
-        // ways of doing it, depending on the size of T.
-        if (other.value_ != 0) {
-            if (value_ > T_MAX_ / other.value_)
-                return policy_t::too_large("Checked::operator*(Checked)");
-        }
+        auto product = mul_wide(value_, other.value_);
+        if (product.high != 0)
+            return policy_t::too_large("Checked::operator*(Checked)");
 
-        return rebuild_(value_ * other.value_);
+        return rebuild_(product.low);
 #endif
     }
 
@@ -839,7 +1410,7 @@ public:
         if (value_ == 0)
             return rebuild_(0);
 
-        if (other >= sizeof(T) * CHAR_BIT)
+        if (other >= detail::int_traits<T>::width)
             return policy_t::too_large("Checked::operator<<(u_int8_t)");
 
         if (T_MAX_ >> other < value_)
@@ -955,7 +1526,7 @@ class Checked<T, P, std::enable_if_t<P<T>::is_wrapping>>
 {
 private:
     using policy_t = P<T>;
-    using unsigned_t = std::make_unsigned_t<T>;
+    using unsigned_t = detail::make_unsigned_t<T>;
 
     unsigned_t value_;
 
@@ -965,10 +1536,10 @@ private:
     // Make sure we have two's complement numbers, because Wrapping<T> depends
     // on conversion to unsigned and back:
     static_assert(static_cast<unsigned_t>(T(-3)) ==
-                          std::numeric_limits<unsigned_t>::max() - 2,
+                          detail::int_traits<unsigned_t>::max() - 2,
                   "Two's complement check");
     static_assert(static_cast<T>(
-                          std::numeric_limits<unsigned_t>::max() - 2)
+                          detail::int_traits<unsigned_t>::max() - 2)
                   == T(-3),
                   "Two's complement check");
 
@@ -1004,8 +1575,8 @@ public:
 
     /// Wrapping negation.
     constexpr Checked operator-() const {
-        if (get() == std::numeric_limits<T>::min())
-            return Checked(std::numeric_limits<T>::min());
+        if (get() == detail::int_traits<T>::min())
+            return Checked(detail::int_traits<T>::min());
         else
             return Checked(-get());
     }
@@ -1013,8 +1584,8 @@ public:
     /// Absolute value.
     constexpr unsigned_t abs() const
     {
-        if (get() == std::numeric_limits<T>::min()) {
-            return unsigned_t(std::numeric_limits<T>::max()) + 1;
+        if (get() == detail::int_traits<T>::min()) {
+            return unsigned_t(detail::int_traits<T>::max()) + 1;
         } else if (get() < 0) {
             return unsigned_t(-get());
         } else {
@@ -1191,6 +1762,32 @@ using Saturating = Checked<T, policy::saturating>;
 template <class T>
 using Wrapping = Checked<T, policy::wrapping>;
 
+/// The exact double-width product of two checked integers; this never
+/// overflows.
+template <class T, template <class> class P>
+constexpr wide_product<T> mul_wide(Checked<T, P> a, Checked<T, P> b)
+{
+    return mul_wide(a.get(), b.get());
+}
+
+/// `add_carry` on checked unsigned integers; this never overflows, since
+/// the carry is returned separately.
+template <class T, template <class> class P>
+constexpr Checked<T, P>
+add_carry(Checked<T, P> a, Checked<T, P> b, bool carry_in, bool& carry_out)
+{
+    return Checked<T, P>(add_carry(a.get(), b.get(), carry_in, carry_out));
+}
+
+/// `sub_borrow` on checked unsigned integers; this never overflows, since
+/// the borrow is returned separately.
+template <class T, template <class> class P>
+constexpr Checked<T, P>
+sub_borrow(Checked<T, P> a, Checked<T, P> b, bool borrow_in, bool& borrow_out)
+{
+    return Checked<T, P>(sub_borrow(a.get(), b.get(), borrow_in, borrow_out));
+}
+
 /*
  * Checked integer comparisons and stream operations:
  */
@@ -1301,21 +1898,403 @@ constexpr bool operator>=(Checked<T, P> a, U b)
 template <class T, template <class> class P>
 std::ostream& operator<<(std::ostream& o, Checked<T, P> a)
 {
-    return o << a.get();
+    return o << detail::streamable(a.get());
+}
+
+/*
+ * BYTE ORDER
+ */
+
+namespace detail {
+
+/// Writes unsigned `value` at `p` as little-endian bytes.
+template <class U>
+void store_le(uint8_t* p, U value)
+{
+#ifdef XXINT_LITTLE_ENDIAN
+    std::memcpy(p, &value, sizeof value);
+#else
+    for (std::size_t i = 0; i < sizeof value; ++i)
+        p[i] = uint8_t(value >> 8 * i);
+#endif
+}
+
+/// Reads an unsigned `U` stored at `p` as little-endian bytes.
+template <class U>
+U load_le(const uint8_t* p)
+{
+    U value;
+#ifdef XXINT_LITTLE_ENDIAN
+    std::memcpy(&value, p, sizeof value);
+#else
+    value = 0;
+    for (std::size_t i = 0; i < sizeof value; ++i)
+        value = U(value | U(U(p[i]) << 8 * i));
+#endif
+    return value;
+}
+
+/// Reverses the bytes of unsigned `x`.
+template <class U>
+U byte_swap(U x)
+{
+#if __has_builtin(__builtin_bswap64)
+    if (sizeof x == 8) return U(__builtin_bswap64(uint64_t(x)));
+    if (sizeof x == 4) return U(__builtin_bswap32(uint32_t(x)));
+    if (sizeof x == 2) return U(__builtin_bswap16(uint16_t(x)));
+#endif
+    U result = 0;
+    for (std::size_t i = 0; i < sizeof x; ++i) {
+        result = U(result << 8 | U(x & 0xFF));
+        x = U(x >> 8);
+    }
+    return result;
+}
+
+/// Reads an unsigned `U` stored at `p` as big-endian bytes.
+template <class U>
+U load_be(const uint8_t* p)
+{
+#ifdef XXINT_LITTLE_ENDIAN
+    return byte_swap(load_le<U>(p));
+#else
+    U value = 0;
+    for (std::size_t i = 0; i < sizeof value; ++i)
+        value = U(value << 8 | U(p[i]));
+    return value;
+#endif
+}
+
+} // end detail
+
+/*
+ * TEXT CONVERSIONS
+ */
+
+namespace detail {
+
+/// The two-digit decimal strings "00" through "99", back to back, so that
+/// formatting takes one division by 100 per two digits.
+struct digit_pair_table
+{
+    char chars[200];
+
+    constexpr digit_pair_table() : chars()
+    {
+        for (int i = 0; i < 100; ++i) {
+            chars[2 * i]     = char('0' + i / 10);
+            chars[2 * i + 1] = char('0' + i % 10);
+        }
+    }
+};
+
+/// Holds the `digit_pair_table`.
+template <class = void>
+struct digit_pair_holder
+{
+    static constexpr digit_pair_table table{};
+};
+
+template <class Unused>
+constexpr digit_pair_table digit_pair_holder<Unused>::table;
+
+/// The number of decimal digits of `x`, at least 1.
+template <class U>
+constexpr int decimal_digits(U x)
+{
+    // Four digits per division; the divisions are by a constant.
+    for (int result = 1; ; result += 4, x = U(x / 10000)) {
+        if (x < 10) return result;
+        if (x < 100) return result + 1;
+        if (x < 1000) return result + 2;
+        if (x < 10000) return result + 3;
+    }
+}
+
+/// Writes the decimal digits of `magnitude` so that they end just before
+/// `end`, two at a time, and returns where they begin.
+template <class U>
+char* write_digits(U magnitude, char* end)
+{
+    const char* pairs = digit_pair_holder<>::table.chars;
+
+    while (magnitude >= 100) {
+        auto pair = unsigned(magnitude % 100);
+        magnitude = U(magnitude / 100);
+        end -= 2;
+        end[0] = pairs[2 * pair];
+        end[1] = pairs[2 * pair + 1];
+    }
+
+    if (magnitude >= 10) {
+        end -= 2;
+        end[0] = pairs[2 * unsigned(magnitude)];
+        end[1] = pairs[2 * unsigned(magnitude) + 1];
+    } else {
+        *--end = char('0' + unsigned(magnitude));
+    }
+
+    return end;
+}
+
+/// The largest `k` such that `10^k` fits in `T`.
+template <class T>
+constexpr int max_pow10_exponent()
+{
+    int result = 0;
+    for (T n = int_traits<T>::max(); n >= 10; n /= 10)
+        ++result;
+    return result;
+}
+
+/// Accumulates decimal digits into an unsigned magnitude. On overflow it
+/// records the fact and keeps going modulo `2^width`, which is what a
+/// wrapping policy wants.
+template <class U>
+struct digit_accumulator
+{
+    U value = 0;
+    bool overflow = false;
+
+    constexpr void push(unsigned digit)
+    {
+        constexpr U limit = int_traits<U>::max() / 10;
+        constexpr U last  = int_traits<U>::max() % 10;
+
+        if (value > limit || (value == limit && digit > last))
+            overflow = true;
+
+        value = U(value * 10 + digit);
+    }
+
+    constexpr void increment()
+    {
+        if (value == int_traits<U>::max())
+            overflow = true;
+
+        value = U(value + 1);
+    }
+};
+
+/// Converts a parsed sign and magnitude to `T` for a wrapping policy.
+template <class T, template <class> class P, class U>
+constexpr T from_magnitude(bool negative, U magnitude, bool,
+                           const char*, std::true_type /* is_wrapping */)
+{
+    return static_cast<T>(negative ? U(U(0) - magnitude) : magnitude);
+}
+
+/// Converts a parsed sign and magnitude to `T`, applying policy `P` if it
+/// does not fit.
+template <class T, template <class> class P, class U>
+constexpr T from_magnitude(bool negative, U magnitude, bool overflow,
+                           const char* who, std::false_type /* is_wrapping */)
+{
+    if (negative) {
+        if (magnitude == 0 && !overflow)
+            return T(0);
+        if (overflow || !int_traits<T>::is_signed
+                || U(magnitude - 1) > U(int_traits<T>::max()))
+            return P<T>::too_small(who);
+        // Computes -magnitude without overflowing at T's minimum.
+        return T(-T(magnitude - 1) - 1);
+    } else {
+        if (overflow || magnitude > U(int_traits<T>::max()))
+            return P<T>::too_large(who);
+        return T(magnitude);
+    }
+}
+
+/// Converts a parsed sign and magnitude to `T` according to policy `P`.
+template <class T, template <class> class P, class U>
+constexpr T from_magnitude(bool negative, U magnitude, bool overflow,
+                           const char* who)
+{
+    return from_magnitude<T, P>(
+            negative, magnitude, overflow, who,
+            std::integral_constant<bool, P<T>::is_wrapping>());
+}
+
+} // end detail
+
+/// Result of `to_chars`, like `std::to_chars_result`.
+struct to_chars_result
+{
+    char* ptr;
+    std::errc ec;
+};
+
+/// Result of `from_chars`, like `std::from_chars_result`.
+struct from_chars_result
+{
+    const char* ptr;
+    std::errc ec;
+};
+
+/// Formats `value` into `[first, last)` as an optional `-` and its decimal
+/// digits, without going through iostreams or the locale. The digits are
+/// counted first, and then written straight into place two at a time.
+///
+/// On success returns the end of the written characters; if the buffer is
+/// too small, returns `{last, std::errc::value_too_large}`.
+template <class T, template <class> class P>
+to_chars_result to_chars(char* first, char* last, Checked<T, P> value)
+{
+    auto magnitude = detail::magnitude(value.get());
+    bool negative = value.get() < 0;
+
+    std::ptrdiff_t length = negative + detail::decimal_digits(magnitude);
+    if (last - first < length)
+        return {last, std::errc::value_too_large};
+
+    if (negative) *first = '-';
+    detail::write_digits(magnitude, first + length);
+
+    return {first + length, std::errc()};
+}
+
+/// Parses an integer from `[first, last)`: an optional `-` followed by
+/// decimal digits, as `std::from_chars` does, independent of the locale.
+///
+/// Overflow is detected digit by digit and handled by policy `P`: a
+/// throwing policy throws, and a saturating or wrapping policy stores the
+/// saturated or wrapped value. For unsigned `T`, a negative value is too
+/// small. On a syntax error, returns `{first, std::errc::invalid_argument}`
+/// and leaves `value` unchanged.
+template <class T, template <class> class P>
+from_chars_result from_chars(const char* first, const char* last,
+                             Checked<T, P>& value)
+{
+    using U = detail::make_unsigned_t<T>;
+
+    const char* p = first;
+    bool negative = p != last && *p == '-';
+    if (negative) ++p;
+
+    const char* digits = p;
+    detail::digit_accumulator<U> acc;
+
+    // So many digits cannot overflow, so only the digits after them are
+    // checked.
+    constexpr std::ptrdiff_t unchecked = detail::max_pow10_exponent<U>();
+    const char* checked = last - p > unchecked ? p + unchecked : last;
+
+    for (; p != checked && unsigned(*p - '0') < 10; ++p)
+        acc.value = U(acc.value * 10 + unsigned(*p - '0'));
+    for (; p != last && unsigned(*p - '0') < 10; ++p)
+        acc.push(unsigned(*p - '0'));
+
+    if (p == digits)
+        return {first, std::errc::invalid_argument};
+
+    value = Checked<T, P>(detail::from_magnitude<T, P>(
+            negative, acc.value, acc.overflow, "xxint::from_chars(Checked)"));
+
+    return {p, std::errc()};
 }
 
 /// Stream extraction for checked types.
 ///
-/// This reads directly into a variable of type `T`; it performs no checking.
+/// After skipping whitespace, this reads an optional sign and decimal
+/// digits, whatever the stream's base and locale, and converts them as
+/// `from_chars` does, so overflow is handled by policy `P`. If there are
+/// no digits, it sets `failbit` and leaves `a` unchanged.
 template <class T, template <class> class P>
 std::istream& operator>>(std::istream& i, Checked<T, P>& a)
 {
-    T temp;
-    i >> temp;
-    a = Checked<T, P>(temp);
+    using traits = std::istream::traits_type;
+    using U = detail::make_unsigned_t<T>;
+
+    std::istream::sentry sentry(i);
+    if (!sentry) return i;
+
+    std::streambuf* buffer = i.rdbuf();
+    auto c = buffer->sgetc();
+
+    bool negative = c == '-';
+    if (negative || c == '+') c = buffer->snextc();
+
+    detail::digit_accumulator<U> acc;
+    bool any_digits = false;
+
+    while (c != traits::eof() && unsigned(c - '0') < 10) {
+        acc.push(unsigned(c - '0'));
+        any_digits = true;
+        c = buffer->snextc();
+    }
+
+    std::ios_base::iostate state = std::ios_base::goodbit;
+    if (c == traits::eof()) state |= std::ios_base::eofbit;
+
+    if (any_digits) {
+        a = Checked<T, P>(detail::from_magnitude<T, P>(
+                negative, acc.value, acc.overflow,
+                "xxint::operator>>(Checked)"));
+    } else {
+        state |= std::ios_base::failbit;
+    }
+
+    i.setstate(state);
     return i;
 }
 
+/*
+ * HASHING
+ */
+
+/// Mixes the bits of `x` so that each input bit affects each output bit
+/// with probability near 1/2. This is the finalizer of SplitMix64, two
+/// multiplies and three shifts, and it is a bijection, so distinct words
+/// never collide.
+constexpr uint64_t hash_mix(uint64_t x)
+{
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+    return x ^ (x >> 31);
+}
+
+/// Combines the hash `seed` with another word, order-dependently.
+constexpr uint64_t hash_combine(uint64_t seed, uint64_t value)
+{
+    return hash_mix(seed ^ (value + 0x9e3779b97f4a7c15
+                            + (seed << 6) + (seed >> 2)));
+}
+
+namespace detail {
+
+/// Hashes an integer of any width. Values that fit in a 64-bit word are
+/// sign- or zero-extended to one, so equal values hash equally whatever
+/// their types; wider values combine each further word.
+template <class T>
+constexpr uint64_t hash_integer(T value)
+{
+    using word = std::conditional_t<int_traits<T>::is_signed,
+                                    int64_t, uint64_t>;
+
+    uint64_t result = hash_mix(uint64_t(static_cast<word>(value)));
+    if (static_cast<word>(value) != value) {
+        for (int shift = 64; shift < int_traits<T>::width; shift += 64)
+            result = hash_combine(result, uint64_t(value >> shift));
+    }
+    return result;
+}
+
+} // end detail
+
+}
+
+namespace std {
+
+/// Hashes checked integers by value, with `xxint::hash_mix`.
+template <class T, template <class> class P>
+struct hash<xxint::Checked<T, P>>
+{
+    size_t operator()(xxint::Checked<T, P> a) const noexcept
+    {
+        return static_cast<size_t>(xxint::detail::hash_integer(a.get()));
+    }
+};
+
 }
 
 #endif